@@ -0,0 +1,342 @@
+import { existsSync, readFileSync, writeFileSync } from "fs";
+import { resolve } from "./utils.mjs";
+
+// The BIP-39 languages, in the order of FfxBip39Language; each is
+// included if its lang-*.txt is present
+const LANGUAGES = [
+    { code: "en", name: "English" },
+    { code: "es", name: "Spanish" },
+    { code: "fr", name: "French" },
+    { code: "it", name: "Italian" },
+    { code: "cs", name: "Czech" },
+    { code: "pt", name: "Portuguese" },
+    { code: "ja", name: "Japanese", separator: "　" },
+    { code: "ko", name: "Korean" },
+    { code: "zh-cn", name: "ChineseSimplified" },
+    { code: "zh-tw", name: "ChineseTraditional" },
+];
+
+
+/////////////////////////////
+// Format
+//
+// Words are stored as NFKD-normalized (as used for the seed) UTF-8
+// bytes. The bytes are not packed any further (e.g. as 5-bit letters),
+// as unpacking each word would make decoding slower than the plain
+// strings this replaces.
+//
+// The words are split into groups of GROUP_SIZE, which omit the prefix
+// (up to 4 bytes) shared by the whole group, which for a sorted list is
+// usually at least the first letter. Each group stores its prefix (as a
+// single 32-bit value) and each word stores its offset, so decoding a
+// word is the group prefix followed by the bytes up to the offset of
+// the next word. Words of up to 8 bytes are decoded with a single load.
+//
+// The word index is a minimal perfect hash over a hash of the word,
+// which mixes 8 bytes at a time (so most words are a single step). Each
+// key hashes into one of BUCKET_COUNT buckets, and a seed is found for
+// each bucket which maps its keys to unused slots, so looking up a word
+// is two hashes and a comparison against a single candidate.
+//
+// For prefix lookups, the words are searched in byte order. Lists which
+// are not already in byte order include the word index of each word in
+// byte order, and each list includes the first position (in byte order)
+// of the words starting with each first byte, which narrows the search.
+//
+// These MUST match the C implementation in bip32.c.
+
+const WORD_COUNT = 2048;
+const GROUP_SIZE = 16;
+const BUCKET_COUNT = 512;
+const MAX_PREFIX = 4;
+
+// Including the NULL-terminator; see FFX_BIP39_MAX_WORD_LENGTH
+const MAX_WORD_LENGTH = 48;
+
+const MASK64 = (1n << 64n) - 1n;
+
+function getKey(bytes) {
+    let key = BigInt(bytes.length);
+    for (let i = 0; i < bytes.length; i += 8) {
+        let chunk = 0n;
+        bytes.slice(i, i + 8).forEach((b, j) => {
+            chunk |= BigInt(b) << BigInt(8 * j);
+        });
+        key = ((key ^ chunk) * 0x9e3779b97f4a7c15n) & MASK64;
+        key ^= key >> 32n;
+    }
+    return Number(key & 0xffffffffn);
+}
+
+function hash(key, seed) {
+    let h = Math.imul((key ^ Math.imul(seed, 0x9e3779b9)) >>> 0, 0x85ebca6b);
+    h = (h ^ (h >>> 13)) >>> 0;
+    h = Math.imul(h, 0xc2b2ae35);
+    return (h ^ (h >>> 16)) >>> 0;
+}
+
+function getHash(words) {
+    const buckets = [ ];
+    for (let i = 0; i < BUCKET_COUNT; i++) { buckets.push([ ]); }
+
+    const keys = new Set();
+    words.forEach((word, index) => {
+        const key = getKey(word);
+        if (keys.has(key)) { throw new Error(`duplicate key: ${ word }`); }
+        keys.add(key);
+        buckets[hash(key, 0) % BUCKET_COUNT].push({ key, index });
+    });
+
+    const seeds = new Array(BUCKET_COUNT).fill(0);
+    const slots = new Array(WORD_COUNT).fill(-1);
+
+    // Place the largest buckets first, while there are more free slots
+    const order = buckets.map((b, i) => i);
+    order.sort((a, b) => (buckets[b].length - buckets[a].length));
+
+    for (const b of order) {
+        const bucket = buckets[b];
+        if (bucket.length === 0) { continue; }
+
+        let seed = 1;
+        for (; seed < 0x10000; seed++) {
+            const s = bucket.map(({ key }) => hash(key, seed) % WORD_COUNT);
+            if (new Set(s).size !== s.length) { continue; }
+            if (s.filter((slot) => (slots[slot] !== -1)).length) { continue; }
+
+            s.forEach((slot, i) => { slots[slot] = bucket[i].index; });
+            break;
+        }
+        if (seed === 0x10000) { throw new Error("no seed found"); }
+
+        seeds[b] = seed;
+    }
+
+    return { seeds, slots };
+}
+
+function getPrefixLength(words) {
+    let length = MAX_PREFIX;
+    for (const word of words) {
+        if (word.length < length) { length = word.length; }
+        while (length && words[0].slice(0, length).join(",") !==
+          word.slice(0, length).join(",")) {
+            length--;
+        }
+    }
+    return length;
+}
+
+function compareBytes(a, b) {
+    for (let i = 0; i < a.length && i < b.length; i++) {
+        if (a[i] !== b[i]) { return a[i] - b[i]; }
+    }
+    return a.length - b.length;
+}
+
+function getSorted(words) {
+    const order = words.map((w, i) => i);
+    order.sort((a, b) => compareBytes(words[a], words[b]));
+
+    // Sorted lists do not need the permutation
+    const sorted = order.every((index, i) => (index === i)) ? null: order;
+
+    const firstByte = words[order[0]][0];
+    const lastByte = words[order[WORD_COUNT - 1]][0];
+
+    const starts = [ ];
+    for (let b = firstByte; b <= lastByte + 1; b++) {
+        starts.push(order.findIndex((index) => (words[index][0] >= b)));
+    }
+    starts[starts.length - 1] = WORD_COUNT;
+
+    return { sorted, firstByte, starts };
+}
+
+function pack(language, words) {
+    const maxLength = Math.max(...words.map((w) => w.length));
+    if (maxLength + 1 > MAX_WORD_LENGTH) { throw new Error("word too long"); }
+
+    const data = [ ];
+    const offsets = [ ];
+    const prefixes = [ ];
+    const prefixBytes = [ ];
+    for (let g = 0; g < WORD_COUNT; g += GROUP_SIZE) {
+        const group = words.slice(g, g + GROUP_SIZE);
+        const prefixLength = getPrefixLength(group);
+        prefixes.push(prefixLength);
+
+        // The prefix bytes, little-endian
+        let value = 0;
+        group[0].slice(0, prefixLength).forEach((b, i) => {
+            value += b * 2 ** (8 * i);
+        });
+        prefixBytes.push(value);
+
+        for (const word of group) {
+            offsets.push(data.length);
+            for (const b of word.slice(prefixLength)) { data.push(b); }
+        }
+    }
+    offsets.push(data.length);
+    if (data.length > 0xffff) { throw new Error("wordlist too large"); }
+
+    // Trailing bytes, so reading from any word can load 8 bytes
+    for (let i = 0; i < 7; i++) { data.push(0); }
+
+    const { seeds, slots } = getHash(words);
+
+    const { sorted, firstByte, starts } = getSorted(words);
+
+    const size = data.length + 2 * offsets.length + 5 * prefixes.length +
+      2 * seeds.length + 2 * slots.length +
+      2 * starts.length + (sorted ? 2 * sorted.length: 0);
+    console.log(`  ${ language.name }: ${ size } bytes${ sorted ? " (unsorted)": "" }`);
+
+    return {
+        data, offsets, prefixes, prefixBytes, seeds, slots, sorted, firstByte,
+        starts
+    };
+}
+
+
+function hex(v, length) {
+    v = v.toString(16);
+    while (v.length < length) { v = "0" + v; }
+    return `0x${ v }`
+}
+
+function pushTable(lines, decl, values, length) {
+    lines.push(`${ decl } = {`);
+    const perLine = (length === 2) ? 12: (length === 4) ? 8: 6;
+    for (let i = 0; i < values.length; i += perLine) {
+        const l = values.slice(i, i + perLine).map((v) => `${ hex(v, length) },`);
+        lines.push("    " + l.join(" "));
+    }
+    lines.push("};");
+}
+
+function cString(value) {
+    return Array.from(Buffer.from(value)).map((b) => {
+        if (b >= 32 && b < 127 && b !== 34 && b !== 92) {
+            return String.fromCharCode(b);
+        }
+        return `\\x${ hex(b, 2).substring(2) }`;
+    }).join("");
+}
+
+const lines = [ ];
+lines.push("#ifndef __BIP39_WORDLISTS_H__");
+lines.push("#define __BIP39_WORDLISTS_H__");
+lines.push("");
+lines.push("// This file is generated! Do NOT modify manually. See export-bip39.mjs.");
+lines.push("");
+lines.push("#ifdef __cplusplus");
+lines.push('extern "C" {');
+lines.push("#endif /* __cplusplus */");
+lines.push("");
+lines.push("#include <stdbool.h>");
+lines.push("#include <stddef.h>");
+lines.push("#include <stdint.h>");
+lines.push("");
+lines.push(`#define WORDLIST_GROUP_SIZE           (${ GROUP_SIZE })`);
+lines.push(`#define WORDLIST_BUCKET_COUNT         (${ BUCKET_COUNT })`);
+lines.push(`#define WORDLIST_MAX_WORD_LENGTH      (${ MAX_WORD_LENGTH })`);
+lines.push("");
+lines.push("typedef struct Wordlist {");
+lines.push("    const char *separator;");
+lines.push("");
+lines.push("    const uint8_t *data;");
+lines.push("");
+lines.push("    // The offset of each word (excluding the group prefix), with a final");
+lines.push("    // entry of the data length");
+lines.push("    const uint16_t *offsets;");
+lines.push("");
+lines.push("    // The length of the prefix shared by each group and its bytes,");
+lines.push("    // little-endian");
+lines.push("    const uint8_t *prefixes;");
+lines.push("    const uint32_t *prefixBytes;");
+lines.push("");
+lines.push("    // The perfect hash seed for each bucket and word index for each slot");
+lines.push("    const uint16_t *seeds;");
+lines.push("    const uint16_t *slots;");
+lines.push("");
+lines.push("    // The word index of each word in byte order (NULL if the list is");
+lines.push("    // already in byte order)");
+lines.push("    const uint16_t *sorted;");
+lines.push("");
+lines.push("    // The first position (in byte order) of the words starting with");
+lines.push("    // each byte in [firstByte, firstByte + startCount - 1), with a");
+lines.push("    // final entry of 2048");
+lines.push("    uint8_t firstByte;");
+lines.push("    uint16_t startCount;");
+lines.push("    const uint16_t *starts;");
+lines.push("} Wordlist;");
+lines.push("");
+
+const entries = [ ];
+
+console.log("Wordlists:");
+for (const language of LANGUAGES) {
+    const filename = resolve(`lang-${ language.code }.txt`);
+    if (!existsSync(filename)) {
+        entries.push(`    { 0 },  // ${ language.name } (not included)`);
+        continue;
+    }
+
+    const words = readFileSync(filename).toString().trim().split("\n").map((w) => {
+        return Array.from(Buffer.from(w.trim().normalize("NFKD")));
+    });
+    if (words.length !== WORD_COUNT) { throw new Error("bad list!"); }
+
+    const result = pack(language, words);
+
+    const id = language.code.replace(/-(.)/g, (all, c) => c.toUpperCase());
+    const prefix = `_ffx_bip39_${ id }`;
+
+    lines.push(`// ${ language.name } (lang-${ language.code }.txt)`);
+    pushTable(lines, `const uint8_t ${ prefix }Data[${ result.data.length }]`, result.data, 2);
+    pushTable(lines, `const uint16_t ${ prefix }Offsets[${ result.offsets.length }]`, result.offsets, 4);
+    pushTable(lines, `const uint8_t ${ prefix }Prefixes[${ result.prefixes.length }]`, result.prefixes, 2);
+    pushTable(lines, `const uint32_t ${ prefix }PrefixBytes[${ result.prefixBytes.length }]`, result.prefixBytes, 8);
+    pushTable(lines, `const uint16_t ${ prefix }Seeds[${ result.seeds.length }]`, result.seeds, 4);
+    pushTable(lines, `const uint16_t ${ prefix }Slots[${ result.slots.length }]`, result.slots, 4);
+    if (result.sorted) {
+        pushTable(lines, `const uint16_t ${ prefix }Sorted[${ result.sorted.length }]`, result.sorted, 4);
+    }
+    pushTable(lines, `const uint16_t ${ prefix }Starts[${ result.starts.length }]`, result.starts, 4);
+    lines.push("");
+
+    entries.push([
+        `    {   // ${ language.name }`,
+        `        .separator = "${ cString(language.separator || " ") }",`,
+        `        .data = ${ prefix }Data,`,
+        `        .offsets = ${ prefix }Offsets,`,
+        `        .prefixes = ${ prefix }Prefixes,`,
+        `        .prefixBytes = ${ prefix }PrefixBytes,`,
+        `        .seeds = ${ prefix }Seeds,`,
+        `        .slots = ${ prefix }Slots,`,
+        `        .sorted = ${ result.sorted ? `${ prefix }Sorted`: "NULL" },`,
+        `        .firstByte = ${ hex(result.firstByte, 2) },`,
+        `        .startCount = ${ result.starts.length },`,
+        `        .starts = ${ prefix }Starts,`,
+        `    },`
+    ].join("\n"));
+}
+
+lines.push(`const Wordlist _ffx_bip39_wordlists[${ LANGUAGES.length }] = {`);
+for (const entry of entries) { lines.push(entry); }
+lines.push("};");
+
+lines.push("");
+lines.push("#ifdef __cplusplus");
+lines.push("}");
+lines.push("#endif /* __cplusplus */");
+lines.push("");
+lines.push("#endif /* __BIP39_WORDLISTS_H__ */");
+
+{
+    const filename = resolve("../src/bip39-wordlists.h");
+    console.log(`Writing: ${ filename }`);
+    writeFileSync(filename, lines.join("\n"));
+}
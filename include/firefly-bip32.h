@@ -10,6 +10,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 
+#include "firefly-address.h"
 #include "firefly-ecc.h"
 
 ///////////////////////////////
@@ -28,20 +29,119 @@ FfxWordlistIterator ffx_bip39_iterate();
 bool ffx_bip39_nextWord(FfxWordlistIterator *iterator);
 */
 
+/**
+ *  The BIP-39 wordlist languages.
+ *
+ *  Only the wordlists present in the db/ folder when the wordlists were
+ *  generated are included; see [[ffx_bip39_hasLanguage]].
+ */
+typedef enum FfxBip39Language {
+    FfxBip39LanguageEnglish = 0,
+    FfxBip39LanguageSpanish,
+    FfxBip39LanguageFrench,
+    FfxBip39LanguageItalian,
+    FfxBip39LanguageCzech,
+    FfxBip39LanguagePortuguese,
+    FfxBip39LanguageJapanese,
+    FfxBip39LanguageKorean,
+    FfxBip39LanguageChineseSimplified,
+    FfxBip39LanguageChineseTraditional,
+} FfxBip39Language;
+
+// The longest word (in UTF-8 bytes) including the NULL-terminator
+#define FFX_BIP39_MAX_WORD_LENGTH       (48)
+
+// Returns true if the wordlist for %%language%% is included
+bool ffx_bip39_hasLanguage(FfxBip39Language language);
+
+// Returns the index of the English word (or -1 if not present)
+int ffx_bip39_index(const char* const word);
+
+/**
+ *  Returns the index of %%word%% (of %%length%% bytes) in the %%language%%
+ *  wordlist, or -1 if not present.
+ *
+ *  Words are matched in NFKD normalized form (as used for the seed), so
+ *  words with accents or in non-Latin scripts must be normalized first.
+ */
+int ffx_bip39_getIndex(FfxBip39Language language, const char* word,
+  size_t length);
+
+/**
+ *  Writes the NULL-terminated word at %%index%% of the %%language%%
+ *  wordlist to %%wordOut%%, which must be at least
+ *  [[FFX_BIP39_MAX_WORD_LENGTH]] bytes, returning its length.
+ *
+ *  Returns 0 (with an empty %%wordOut%%) if %%index%% is outside the
+ *  range [0, 2047] or the language is not included.
+ */
+size_t ffx_bip39_getWord(FfxBip39Language language, int index,
+  char *wordOut);
+
+/**
+ *  Returns the number of words in the %%language%% wordlist which begin
+ *  with %%prefix%% (of %%length%% bytes; NFKD normalized), setting
+ *  %%startOut%% to the position of the first of them in byte order.
+ *
+ *  The matching words are the positions [start, start + count), which
+ *  can be converted to word indices using [[ffx_bip39_getSortedIndex]].
+ *
+ *  This is a binary search over a generated index, so is suitable to
+ *  call on every keystroke of word entry.
+ */
+size_t ffx_bip39_getPrefixRange(FfxBip39Language language,
+  const char* prefix, size_t length, int *startOut);
+
+/**
+ *  Returns the word index of the word at %%position%% in byte order of
+ *  the %%language%% wordlist, or -1 if out of range.
+ *
+ *  Most wordlists are in byte order, in which case this is %%position%%.
+ */
+int ffx_bip39_getSortedIndex(FfxBip39Language language, int position);
+
+/**
+ *  Returns the length (in bytes) of the shortest prefix of the word at
+ *  %%index%% which no other word begins with, or its full length if it
+ *  is itself the prefix of another word (e.g. "act" and "action").
+ *
+ *  Returns 0 if %%index%% is out of range or the language is not
+ *  included.
+ */
+size_t ffx_bip39_getUniquePrefixLength(FfxBip39Language language,
+  int index);
+
+
+///////////////////////////////
+// BIP39 Wordlist - deprecated
+//
+// The English-only API, which returned pointers into the plain strings
+// the wordlist was previously stored as. The wordlists are now packed,
+// so the returned word is decoded into a static buffer, which is
+// overwritten by the next call to any of these (and is not thread-safe).
+// Use ffx_bip39_getWord instead.
+
+#define FFX_BIP39_DEPRECATED    __attribute__((deprecated))
+
 typedef struct FfxWordlistCursor {
     size_t index;
     size_t offset;
     size_t length;
 } FfxWordlistCursor;
 
+// Returns the English word at index (or NULL if outside the range
+// [0, 2047])
+const char* ffx_bip39_word(int index) FFX_BIP39_DEPRECATED;
 
-// Returns the index of the word (or -1 if not present)
-int ffx_bip39_index(const char* const word);
-
-// Returns the word at index (or NULL if outside the range [0, 2047])
-const char* ffx_bip39_word(int index);
+// Returns the next English word of %%cursor%% (which must begin zeroed)
+// setting %%index%% to its index, or NULL (with -1) once the end is
+// reached
+const char* ffx_bip39_nextWord(FfxWordlistCursor *cursor, int *index)
+  FFX_BIP39_DEPRECATED;
 
-const char* ffx_bipd39_nextWord(FfxWordlistCursor *cursor, int *index);
+// The previously declared (misspelled) name of ffx_bip39_nextWord
+const char* ffx_bipd39_nextWord(FfxWordlistCursor *cursor, int *index)
+  FFX_BIP39_DEPRECATED;
 
 
 ///////////////////////////////
@@ -55,6 +155,9 @@ typedef struct FfxMnemonic {
     size_t wordCount;
     size_t entropyLength;
     uint8_t entropy[33]; // Incudes checksum (but entropyLength does not)
+
+    // The wordlist used for the words and phrase
+    FfxBip39Language language;
 } FfxMnemonic;
 
 
@@ -68,6 +171,16 @@ typedef struct FfxMnemonic {
  */
 bool ffx_mnemonic_initPhrase(FfxMnemonic *mnemonic, const char* phrase);
 
+/**
+ *  Initialize a %%mnemonic%% with the %%phrase%% in the %%language%%
+ *  wordlist, whose words must be NFKD normalized.
+ *
+ *  Words may be separated by any whitespace or an ideographic space
+ *  (U+3000), which Japanese phrases use.
+ */
+bool ffx_mnemonic_initPhraseWithLanguage(FfxMnemonic *mnemonic,
+  const char* phrase, FfxBip39Language language);
+
 /**
  *  Initialize a %%mnemonic%% with the %%entropy%% and length.
  *
@@ -77,10 +190,21 @@ bool ffx_mnemonic_initEntropy(FfxMnemonic *mnemonic, const uint8_t* entropy,
   size_t length);
 
 /**
- *  Returns the %%index%% word of %%mnemonic%% or NULL if %%index%% is out
- *  of range.
+ *  Sets the wordlist %%language%% used for the words and phrase of
+ *  %%mnemonic%% (which is English after [[ffx_mnemonic_initEntropy]]).
+ *
+ *  Returns false if the language is not included.
  */
-const char* ffx_mnemonic_getWord(FfxMnemonic *mnemonic, int index);
+bool ffx_mnemonic_setLanguage(FfxMnemonic *mnemonic,
+  FfxBip39Language language);
+
+/**
+ *  Writes the NULL-terminated %%index%% word of %%mnemonic%% to
+ *  %%wordOut%%, which must be at least [[FFX_BIP39_MAX_WORD_LENGTH]]
+ *  bytes, returning its length or 0 if %%index%% is out of range.
+ */
+size_t ffx_mnemonic_getWord(FfxMnemonic *mnemonic, int index,
+  char *wordOut);
 
 /**
  *  Returns the length of the phrase for %%mnemonic%% including the
@@ -102,10 +226,24 @@ bool ffx_mnemonic_getPhrase(FfxMnemonic *mnemonic, char* phraseOut,
  *  [[FFX_BIP39_SEED_LENGTH]], for %%mnemonic%% with %%password%%.
  *
  *  If there is no password, use the default password of the empty string, "".
+ *
+ *  The %%password%% must be ASCII, as it is not NFKD normalized, otherwise
+ *  false is returned.
  */
 bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
   uint8_t *seedOut);
 
+/**
+ *  Writes the seeds for each of the %%count%% %%mnemonics%% with
+ *  %%password%% consecutively to %%seedsOut%% (which MUST be of length
+ *  %%count%% * [[FFX_BIP39_SEED_LENGTH]]).
+ *
+ *  This is equivalent to calling [[ffx_mnemonic_getSeed]] for each, but
+ *  on hosts with SIMD support several seeds are derived in parallel.
+ */
+bool ffx_mnemonic_getSeedBatch(FfxMnemonic *mnemonics, size_t count,
+  const char* password, uint8_t *seedsOut);
+
 
 ///////////////////////////////
 // HD Node
@@ -124,10 +262,56 @@ bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
  */
 #define FfxDefaultMnemonicPath ("m/44'/60'/0'/0/0")
 
-//#define FFX_HDNODE_EXTENDED_KEY_MAX_LENGTH
+/**
+ *  The maximum number of components in an [[FfxHDPath]].
+ */
+#define FFX_HDPATH_MAX_DEPTH                   (10)
+
+/**
+ *  A parsed path, so deriving the same path repeatedly (for example,
+ *  in a loop over seeds) does not parse (and validate) it each time.
+ *
+ *  If %%root%%, the path begins with ``m`` and may only be derived
+ *  from a root node.
+ */
+typedef struct FfxHDPath {
+    uint32_t indices[FFX_HDPATH_MAX_DEPTH];
+    size_t depth;
+    bool root;
+} FfxHDPath;
+
+/**
+ *  Initializer for a constant [[FfxHDPath]] from the root with the
+ *  indices given, such as:
+ *
+ *  ``static const FfxHDPath path = FFX_HDPATH(FfxHDNodeHardened | 44,``
+ *  ``  FfxHDNodeHardened | 60, FfxHDNodeHardened | 0, 0, 0);``
+ */
+#define FFX_HDPATH(...) { \
+    .indices = { __VA_ARGS__ }, \
+    .depth = sizeof((uint32_t[]){ __VA_ARGS__ }) / sizeof(uint32_t), \
+    .root = true \
+}
+
+/**
+ *  Initializer for the [[FfxHDPath]] of [[FfxDefaultMnemonicPath]].
+ */
+#define FFX_HDPATH_DEFAULT_MNEMONIC FFX_HDPATH(FfxHDNodeHardened | 44, \
+  FfxHDNodeHardened | 60, FfxHDNodeHardened | 0, 0, 0)
+
+/**
+ *  The length of an extended key (an xpub or xprv), including the
+ *  null-termination.
+ */
+#define FFX_HDNODE_EXTENDED_KEY_MAX_LENGTH     (112)
 
 /**
  *  An Hierarchal-Deterministic Node.
+ *
+ *  The public key of a private node is memoized once computed (which
+ *  deriving any child requires), so each level of derivation performs
+ *  at most one point multiplication and the public key of a node is
+ *  never computed twice.
  */
 typedef struct FfxHDNode {
     bool neutered;
@@ -141,34 +325,206 @@ typedef struct FfxHDNode {
 
     uint32_t depth;
     uint32_t index;
+
+    // The compressed public key of a private node, memoized once
+    // computed (a neutered node's key is its public key)
+    bool hasPubkey;
+    FfxEcCompPubkey pubkey;
+
+    // The fingerprint of the parent (0 for the root)
+    uint32_t parentFingerprint;
 } FfxHDNode;
 
+/**
+ *  The deepest node (relative to the node derivation started from)
+ *  stored in an [[FfxHDNodeCache]].
+ */
+#define FFX_HDNODE_CACHE_MAX_DEPTH       (5)
+
+/**
+ *  A cached node, derived by %%indices%% from the node with %%chaincode%%
+ *  and %%key%% (its private key, or public key if neutered).
+ */
+typedef struct FfxHDNodeCacheEntry {
+    uint8_t chaincode[32];
+    uint8_t key[33];
+    uint32_t indices[FFX_HDNODE_CACHE_MAX_DEPTH];
+    size_t depth;
+
+    uint32_t used;
+
+    FfxHDNode node;
+} FfxHDNodeCacheEntry;
+
+/**
+ *  A least-recently-used cache of intermediate nodes, so deriving
+ *  several paths which share a parent (such as consecutive accounts)
+ *  only derives the parent once.
+ *
+ *  The entries are owned by the caller and contain private keys, so
+ *  should be cleared with [[ffx_hdnode_clearCache]] when done.
+ */
+typedef struct FfxHDNodeCache {
+    FfxHDNodeCacheEntry *entries;
+    size_t count;
+
+    uint32_t tick;
+} FfxHDNodeCache;
+
+/**
+ *  Initialize %%cache%% to use the %%count%% %%entries%%.
+ */
+void ffx_hdnode_initCache(FfxHDNodeCache *cache,
+  FfxHDNodeCacheEntry *entries, size_t count);
+
+/**
+ *  Clears every entry of %%cache%%.
+ */
+void ffx_hdnode_clearCache(FfxHDNodeCache *cache);
+
 /**
  *  Initialize an HDNode for %%seed%%.
  */
 bool ffx_hdnode_initSeed(FfxHDNode *node, const uint8_t *seed);
 
-//bool ffx_hdnode_initExtkey(FfxHDNode *node, const char *extkey);
+/**
+ *  Initialize an HDNode for the Base58Check extended key %%extkey%% (an
+ *  xprv or an xpub, which is neutered), returning false if it is
+ *  malformed, has a bad checksum or has an invalid key.
+ */
+bool ffx_hdnode_initExtkey(FfxHDNode *node, const char *extkey);
 
 /**
  *  Derives the %%index%% child of %%node%%, returning false on failure.
  */
 bool ffx_hdnode_deriveChild(FfxHDNode *node, uint32_t index);
 
+/**
+ *  Derives the %%count%% consecutive non-hardened children of %%parent%%
+ *  starting at %%startIndex%% into %%childrenOut%%, returning false on
+ *  failure (including if any index would be hardened).
+ *
+ *  This is equivalent to [[ffx_hdnode_deriveChild]] for each index, but
+ *  the parent public key and HMAC key are only computed once, the
+ *  children of a private parent need no point multiplication and the
+ *  children of a neutered parent share a single parse of its point.
+ *
+ *  This is useful for scanning a range of addresses (such as for the
+ *  gap limit) of an account.
+ */
+bool ffx_hdnode_deriveChildren(const FfxHDNode *parent, uint32_t startIndex,
+  size_t count, FfxHDNode *childrenOut);
+
+/**
+ *  A job computing the addresses of a range of non-hardened children of
+ *  a %%parent%% (usually a neutered account node), which can be shared
+ *  by a pool of workers (e.g. threads or tasks).
+ *
+ *  Each worker calls [[ffx_hdnode_runAddressJob]], which claims chunks
+ *  of the range until none remain, so workers which are slower (or
+ *  start later) take fewer chunks. Results are written directly to the
+ *  caller's arrays and nothing is allocated.
+ */
+typedef struct FfxHDNodeAddressJob {
+    // The parent (with its public key memoized) and its fingerprint,
+    // computed once and shared by the workers
+    FfxHDNode parent;
+    uint32_t fingerprint;
+
+    uint32_t startIndex;
+    size_t count;
+
+    FfxAddress *addressesOut;
+    FfxChecksumAddress *checksumsOut;
+
+    // Updated atomically by the workers
+    size_t nextChunk;
+    bool failed;
+} FfxHDNodeAddressJob;
+
+/**
+ *  Initialize %%job%% to compute the addresses of the %%count%% children
+ *  of %%parent%% starting at %%startIndex%%, writing each to
+ *  %%addressesOut%% and, if non-NULL, its checksum address to
+ *  %%checksumsOut%% (each of which must hold %%count%% entries).
+ *
+ *  Returns false if any index would be hardened.
+ */
+bool ffx_hdnode_initAddressJob(FfxHDNodeAddressJob *job,
+  const FfxHDNode *parent, uint32_t startIndex, size_t count,
+  FfxAddress *addressesOut, FfxChecksumAddress *checksumsOut);
+
+/**
+ *  Computes addresses for %%job%% until none remain, returning false if
+ *  any derivation (by any worker) failed.
+ *
+ *  This may be called concurrently by any number of workers; the job is
+ *  complete once every call has returned.
+ */
+bool ffx_hdnode_runAddressJob(FfxHDNodeAddressJob *job);
+
+/**
+ *  Computes the addresses (and checksum addresses, if %%checksumsOut%%
+ *  is non-NULL) of the %%count%% children of %%parent%% starting at
+ *  %%startIndex%% on the calling thread.
+ */
+bool ffx_hdnode_getAddresses(const FfxHDNode *parent, uint32_t startIndex,
+  size_t count, FfxAddress *addressesOut, FfxChecksumAddress *checksumsOut);
+
 /**
  *  Derives the child given by %%path%% for %%node%%, returning false
  *  on failure.
  */
 bool ffx_hdnode_derivePath(FfxHDNode *node, const char* path);
 
+/**
+ *  Derives the child given by %%path%% for %%node%%, starting from the
+ *  deepest ancestor in %%cache%% and adding each intermediate node it
+ *  derives to %%cache%%, returning false on failure.
+ *
+ *  For example, after deriving ``m/44'/60'/0'/0/0``, deriving
+ *  ``m/44'/60'/0'/0/1`` only derives a single child.
+ */
+bool ffx_hdnode_derivePathWithCache(FfxHDNode *node, const char* path,
+  FfxHDNodeCache *cache);
+
+/**
+ *  Parses %%path%% into %%pathOut%%, returning false if it is not a
+ *  valid path or has more than [[FFX_HDPATH_MAX_DEPTH]] components.
+ */
+bool ffx_hdnode_parsePath(FfxHDPath *pathOut, const char* path);
+
+/**
+ *  Derives the child given by the parsed %%path%% for %%node%%,
+ *  returning false on failure.
+ */
+bool ffx_hdnode_deriveIndices(FfxHDNode *node, const FfxHDPath *path);
+
+/**
+ *  Derives the child given by the parsed %%path%% for %%node%% as
+ *  [[ffx_hdnode_deriveIndices]], using %%cache%% (see
+ *  [[ffx_hdnode_derivePathWithCache]]).
+ */
+bool ffx_hdnode_deriveIndicesWithCache(FfxHDNode *node,
+  const FfxHDPath *path, FfxHDNodeCache *cache);
+
 /**
  *  Derive the %%account%% for %%node%% using
- *  ``m/44'/60'/${ account }'/0/0``, returning false on faliure.
+ *  ``m/44'/60'/${ account }'/0/0'``, returning false on faliure.
  *
- *  This is the derivation scheme used by Ledger.
+ *  This is similar to the derivation scheme used by Ledger, but the
+ *  final index is hardened; it is kept so existing accounts do not
+ *  change.
  */
 bool ffx_hdnode_deriveAccount(FfxHDNode *node, uint32_t account);
 
+/**
+ *  Derive the %%account%% for %%node%% as [[ffx_hdnode_deriveAccount]],
+ *  using %%cache%% (see [[ffx_hdnode_derivePathWithCache]]).
+ */
+bool ffx_hdnode_deriveAccountWithCache(FfxHDNode *node, uint32_t account,
+  FfxHDNodeCache *cache);
+
 /**
  *  Derive the indexed %%account%% for %%node%% using
  *  ``m/44'/60'/0'/0/${ account }``, returning false on failure.
@@ -177,6 +533,14 @@ bool ffx_hdnode_deriveAccount(FfxHDNode *node, uint32_t account);
  */
 bool ffx_hdnode_deriveIndexedAccount(FfxHDNode *node, uint32_t account);
 
+/**
+ *  Derive the indexed %%account%% for %%node%% as
+ *  [[ffx_hdnode_deriveIndexedAccount]], using %%cache%% (see
+ *  [[ffx_hdnode_derivePathWithCache]]).
+ */
+bool ffx_hdnode_deriveIndexedAccountWithCache(FfxHDNode *node,
+  uint32_t account, FfxHDNodeCache *cache);
+
 /**
  *  Removes the ability to derive child private keys from %%node%%.
  */
@@ -199,7 +563,134 @@ bool ffx_hdnode_getPrivkey(FfxHDNode *node, uint8_t *privkeyOut);
 bool ffx_hdnode_getPubkey(FfxHDNode *node, bool compressed,
   uint8_t *pubkeyOut);
 
-//bool ffx_hdnode_getExtendedKey(FfxHDNode *node, char *extkeyOut);
+/**
+ *  Writes the fingerprint of %%node%% (the first 4 bytes of the hash160
+ *  of its compressed public key) to %%fingerprintOut%%, returning false
+ *  on failure.
+ *
+ *  The fingerprint of the parent of a node is its %%parentFingerprint%%.
+ */
+bool ffx_hdnode_getFingerprint(FfxHDNode *node, uint32_t *fingerprintOut);
+
+/**
+ *  Writes the Base58Check extended key of %%node%% (an xprv, or an xpub
+ *  if neutered) to %%extkeyOut%%, returning false on failure.
+ *
+ *  The length of %%extkeyOut%% must be at least
+ *  [[FFX_HDNODE_EXTENDED_KEY_MAX_LENGTH]].
+ */
+bool ffx_hdnode_getExtendedKey(FfxHDNode *node, char *extkeyOut);
+
+
+///////////////////////////////
+// Mnemonic Recovery
+
+/**
+ *  The maximum number of unknown (or abbreviated) words in a phrase.
+ */
+#define FFX_RECOVERY_MAX_UNKNOWN         (3)
+
+/**
+ *  A search for the mnemonics matching a phrase with unknown words.
+ *
+ *  The candidates are split between workers, each of which searches
+ *  every %%workerCount%%-th candidate with its own context, so the
+ *  search can be spread across threads (or tasks) without any shared
+ *  state; once any worker finds a match, the others can be stopped.
+ *
+ *  Each candidate is first checked against the phrase checksum (in
+ *  parallel batches) and only the valid candidates have their seed and
+ *  address derived.
+ */
+typedef struct FfxMnemonicRecovery {
+    FfxBip39Language language;
+    size_t wordCount;
+    size_t entropyLength;
+
+    // The entropy of the known words
+    uint8_t entropy[33];
+
+    // The word positions of the unknown words, and the range (in byte
+    // order) of the candidates for each
+    size_t unknownCount;
+    uint8_t positions[FFX_RECOVERY_MAX_UNKNOWN];
+    uint16_t starts[FFX_RECOVERY_MAX_UNKNOWN];
+    uint16_t counts[FFX_RECOVERY_MAX_UNKNOWN];
+
+    // The next candidate of this worker, the distance between its
+    // candidates and the total number of candidates (for all workers)
+    uint64_t next;
+    uint32_t stride;
+    uint64_t total;
+
+    // The target address (for the account at path with password)
+    bool hasTarget;
+    FfxAddress target;
+    FfxHDPath path;
+    const char *password;
+
+    // The number of candidates checked, and which were checksum-valid
+    uint64_t checked;
+    uint64_t valid;
+
+    // The match, if found by the last [[ffx_recovery_step]]
+    bool found;
+    FfxMnemonic mnemonic;
+} FfxMnemonicRecovery;
+
+/**
+ *  Initialize %%recovery%% to search for the mnemonics matching
+ *  %%phrase%% in the %%language%% wordlist, as the %%worker%% (in the
+ *  range [0, workerCount - 1]) of %%workerCount%% workers.
+ *
+ *  Each unknown word is either a ``?``, which may be any word, or a
+ *  prefix which matches any words beginning with it (such as the
+ *  4-letter abbreviations which are unique in the English wordlist).
+ *
+ *  Returns false if the phrase has an invalid length, more than
+ *  [[FFX_RECOVERY_MAX_UNKNOWN]] unknown words or a prefix which does not
+ *  match any word.
+ */
+bool ffx_recovery_init(FfxMnemonicRecovery *recovery, const char* phrase,
+  FfxBip39Language language, uint32_t worker, uint32_t workerCount);
+
+/**
+ *  Only match candidates whose account at %%path%% (or the
+ *  [[FfxDefaultMnemonicPath]] if NULL) with %%password%% (or "" if NULL)
+ *  has the %%target%% address.
+ *
+ *  Without a target, every checksum-valid candidate is a match.
+ *
+ *  The %%password%% must remain valid for the duration of the search.
+ *  Returns false if the path is invalid or the password is unsupported.
+ */
+bool ffx_recovery_setTarget(FfxMnemonicRecovery *recovery,
+  const FfxAddress *target, const char* path, const char* password);
+
+/**
+ *  Checks up to %%count%% more candidates of %%recovery%%, returning true
+ *  if a match was found, which is available as the %%mnemonic%% of
+ *  %%recovery%%.
+ *
+ *  Calling again continues the search after the match, until
+ *  [[ffx_recovery_isDone]].
+ *
+ *  For example:
+ *    FfxMnemonicRecovery recovery;
+ *    ffx_recovery_init(&recovery, "legal winner ? year ...",
+ *      FfxBip39LanguageEnglish, 0, 1);
+ *    while (!ffx_recovery_isDone(&recovery)) {
+ *        if (ffx_recovery_step(&recovery, 1024)) {
+ *            // Use recovery.mnemonic
+ *        }
+ *    }
+ */
+bool ffx_recovery_step(FfxMnemonicRecovery *recovery, size_t count);
+
+/**
+ *  Returns true once every candidate of %%recovery%% has been checked.
+ */
+bool ffx_recovery_isDone(const FfxMnemonicRecovery *recovery);
 
 
 
@@ -0,0 +1,126 @@
+#ifndef __FIREFLY_BLOOM_H__
+#define __FIREFLY_BLOOM_H__
+
+#include "firefly-address.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ *  Logs Bloom
+ *
+ *  The 2048-bit filter in each receipt and block header, which each log
+ *  address and topic sets 3 bits of.
+ *
+ *  A bloom may produce false positives, but never false negatives, so it
+ *  can quickly exclude blocks which cannot include a given log.
+ *
+ *  Testing many items against many blooms should prepare each item once
+ *  with [[ffx_bloom_initQuery]], which computes its bits, so that the
+ *  tests do not require any hashing.
+ *
+ *  example:
+ *    FfxBloomQuery query;
+ *    ffx_bloom_initQuery(&query, address.data, sizeof(address.data));
+ *
+ *    uint8_t matches[count];
+ *    ffx_bloom_testBatch(blooms, count, &query, 1, matches);
+ */
+
+#define FFX_BLOOM_LENGTH           (256)
+
+typedef struct FfxBloom {
+    uint8_t data[FFX_BLOOM_LENGTH];
+} FfxBloom;
+
+/**
+ *  The 3 bits of an item, as byte offsets into a bloom with the mask
+ *  of the bit within that byte.
+ */
+typedef struct FfxBloomQuery {
+    uint8_t offsets[3];
+    uint8_t masks[3];
+} FfxBloomQuery;
+
+
+/**
+ *  Initialize %%bloom%% with no bits set.
+ */
+void ffx_bloom_init(FfxBloom *bloom);
+
+/**
+ *  Initialize %%query%% with the bits for the item %%data%% (an address
+ *  or topic).
+ */
+void ffx_bloom_initQuery(FfxBloomQuery *query, const uint8_t *data,
+  size_t length);
+
+/**
+ *  Sets the bits of %%query%% in %%bloom%%.
+ */
+void ffx_bloom_addQuery(FfxBloom *bloom, const FfxBloomQuery *query);
+
+/**
+ *  Sets the bits for the item %%data%% in %%bloom%%.
+ */
+void ffx_bloom_add(FfxBloom *bloom, const uint8_t *data, size_t length);
+
+/**
+ *  Sets the bits for a log from %%address%% with %%topicCount%% 32-byte
+ *  %%topics%% (concatenated) in %%bloom%%.
+ */
+void ffx_bloom_addLog(FfxBloom *bloom, const FfxAddress *address,
+  const uint8_t *topics, size_t topicCount);
+
+/**
+ *  Sets all bits of %%other%% in %%bloom%%, such as to compute a block
+ *  bloom from each receipt bloom.
+ */
+void ffx_bloom_merge(FfxBloom *bloom, const FfxBloom *other);
+
+/**
+ *  Returns true if %%bloom%% may include the item of %%query%%.
+ */
+bool ffx_bloom_test(const FfxBloom *bloom, const FfxBloomQuery *query);
+
+/**
+ *  Returns true if every bit of %%filter%% is set in %%bloom%%.
+ *
+ *  A filter with several items added (e.g. an address and an event
+ *  topic) tests if %%bloom%% may include all of them at once.
+ */
+bool ffx_bloom_includes(const FfxBloom *bloom, const FfxBloom *filter);
+
+/**
+ *  Tests each of %%queryCount%% %%queries%% against each of %%bloomCount%%
+ *  %%blooms%%, setting %%matches%% (which must be %%bloomCount%% *
+ *  %%queryCount%% bytes) at [ bloomIndex * queryCount + queryIndex ] to
+ *  1 if the bloom may include that item and 0 otherwise.
+ *
+ *  Returns the number of matches.
+ */
+size_t ffx_bloom_testBatch(const FfxBloom *blooms, size_t bloomCount,
+  const FfxBloomQuery *queries, size_t queryCount, uint8_t *matches);
+
+/**
+ *  Tests %%filter%% against each of %%bloomCount%% %%blooms%%, setting
+ *  %%matches%% (which must be %%bloomCount%% bytes) to 1 if that bloom
+ *  includes every bit of %%filter%% and 0 otherwise.
+ *
+ *  Returns the number of matches.
+ */
+size_t ffx_bloom_includesBatch(const FfxBloom *blooms, size_t bloomCount,
+  const FfxBloom *filter, uint8_t *matches);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __FIREFLY_BLOOM_H__ */
@@ -6,6 +6,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 
@@ -73,6 +74,19 @@ bool ffx_ec_modMulPrivkey(uint8_t *result32Out, const uint8_t *a32,
 bool ffx_ec_addPointsCompPubkey(uint8_t *result33Out, const uint8_t *a33,
   const uint8_t *b33);
 
+/**
+ *  Computes %%pubkey33%% + %%tweaks32%%[i] * G for each of the %%count%%
+ *  consecutive 32-byte tweaks, writing the compressed points
+ *  consecutively to %%results33Out%% (%%count%% * 33 bytes).
+ *
+ *  Each tweak is added in turn (nothing is batched), but the shared
+ *  point is only parsed once, and unlike [[ffx_ec_addPointsCompPubkey]]
+ *  the tweak points are never serialized and re-parsed. Fails if any
+ *  tweak is not less than the curve order.
+ */
+bool ffx_ec_tweakAddCompPubkeys(uint8_t *results33Out,
+  const uint8_t *pubkey33, const uint8_t *tweaks32, size_t count);
+
 //bool ffx_ec_modAdd(FfxEcPrivkey *resultOut, FfxEcPrivkey *a, FfxEcPrivkey *b);
 //bool ffx_ec_modMul(FfxEcPrivkey *resultOut, FfxEcPrivkey *a, FfxEcPrivkey *b);
 //bool ffx_ec_addPoints(FfxEcPubkey *resultOut, const FfxEcPubkey *a,
@@ -5,12 +5,15 @@
 extern "C" {
 #endif  /* __cplusplus */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
 
 #define FFX_KECCAK256_DIGEST_LENGTH          (32)
 
+#define FFX_RIPEMD160_DIGEST_LENGTH          (20)
+
 #define FFX_SHA256_DIGEST_LENGTH             (32)
 #define FFX_SHA512_DIGEST_LENGTH             (64)
 
@@ -19,7 +22,17 @@ extern "C" {
 #define _ffx_sha3_max_rate_in_qwords (24)
 #define _ffx_sha256_block_length (64)
 #define _ffx_sha512_block_length (128)
+#define _ffx_sha512_lanes (4)
+
 
+/**
+ *  A segment of a message, for hashing data which is not contiguous
+ *  in memory without first copying it into a single buffer.
+ */
+typedef struct FfxHashSegment {
+    const uint8_t *data;
+    size_t length;
+} FfxHashSegment;
 
 typedef struct FfxKeccak256Context {
     /* 1600 bits algorithm hashing state */
@@ -32,6 +45,17 @@ typedef struct FfxKeccak256Context {
     uint16_t rest;
 } FfxKeccak256Context;
 
+/**
+ *  A Keccak256 state which has absorbed a common prefix, which can be
+ *  used to hash many messages sharing that prefix without re-absorbing
+ *  it each time.
+ *
+ *  See: [[ffx_hash_initKeccak256Prefix]]
+ */
+typedef struct FfxKeccak256Prefix {
+    FfxKeccak256Context context;
+} FfxKeccak256Prefix;
+
 typedef struct FfxSha256Context {
     int32_t tot_len;
     uint32_t len;
@@ -46,22 +70,83 @@ typedef struct FfxSha512Context {
     uint64_t h[8];
 } FfxSha512Context;
 
-typedef struct FfxHmacSha256Context {
-    FfxSha256Context ctx_inside;
-    FfxSha256Context ctx_outside;
+/**
+ *  An HMAC key prepared for use with many messages, which holds the
+ *  state of the inner and outer hash after absorbing the padded key.
+ *
+ *  See: [[ffx_hmac_initSha256Key]]
+ */
+typedef struct FfxHmacSha256Key {
+    uint32_t inner[8];
+    uint32_t outer[8];
+} FfxHmacSha256Key;
+
+typedef struct FfxHmacSha512Key {
+    uint64_t inner[8];
+    uint64_t outer[8];
+} FfxHmacSha512Key;
 
-    uint8_t block_ipad[_ffx_sha256_block_length];
-    uint8_t block_opad[_ffx_sha256_block_length];
+typedef struct FfxHmacSha256Context {
+    FfxSha256Context inner;
+    uint32_t outer[8];
 } FfxHmacSha256Context;
 
 typedef struct FfxHmacSha512Context {
-    FfxSha512Context ctx_inside;
-    FfxSha512Context ctx_outside;
-
-    uint8_t block_ipad[_ffx_sha512_block_length];
-    uint8_t block_opad[_ffx_sha512_block_length];
+    FfxSha512Context inner;
+    uint64_t outer[8];
 } FfxHmacSha512Context;
 
+/**
+ *  A PBKDF2 computation in progress, which can be advanced a number of
+ *  iterations at a time.
+ *
+ *  See: [[ffx_pbkdf2_initSha256]]
+ */
+typedef struct FfxPbkdf2Sha256Context {
+    FfxHmacSha256Key key;
+
+    // The running XOR of each U and the previous U (as a padded block)
+    uint32_t result[8];
+    uint8_t block[_ffx_sha256_block_length];
+
+    const uint8_t *salt;
+    size_t saltLength;
+
+    uint8_t *dkOut;
+    size_t dkLength;
+
+    uint32_t iterations;
+
+    // The current block (from 1) and iterations completed within it
+    uint32_t counter;
+    uint32_t iteration;
+} FfxPbkdf2Sha256Context;
+
+typedef struct FfxPbkdf2Sha512Context {
+    FfxHmacSha512Key key;
+
+    uint64_t result[8];
+    uint8_t block[_ffx_sha512_block_length];
+
+    const uint8_t *salt;
+    size_t saltLength;
+
+    uint8_t *dkOut;
+    size_t dkLength;
+
+    uint32_t iterations;
+
+    uint32_t counter;
+    uint32_t iteration;
+} FfxPbkdf2Sha512Context;
+
+/**
+ *  Called with the number of PBKDF2 iterations %%completed%% of the
+ *  %%total%%. Return false to cancel the computation.
+ */
+typedef bool (*FfxPbkdf2ProgressFunc)(uint32_t completed, uint32_t total,
+  void *arg);
+
 
 
 void ffx_hash_initKeccak256(FfxKeccak256Context *context);
@@ -69,15 +154,138 @@ void ffx_hash_updateKeccak256(FfxKeccak256Context *context,
   const uint8_t *data, size_t length);
 void ffx_hash_finalKeccak256(FfxKeccak256Context *context, uint8_t* digest);
 
+/**
+ *  Updates %%context%% with each of the %%count%% %%segments%% in order.
+ *
+ *  Full blocks are processed directly from each segment; only bytes of
+ *  a block which spans segments are buffered in the context. The same
+ *  applies to the SHA-2 variants below.
+ */
+void ffx_hash_updateSegmentsKeccak256(FfxKeccak256Context *context,
+  const FfxHashSegment *segments, size_t count);
+
 void ffx_hash_keccak256(uint8_t *digest, const uint8_t *data, size_t length);
 
+/**
+ *  Copies the state of %%source%% to %%context%%, so the two can then
+ *  be updated independently.
+ *
+ *  Only the live portion of the state is copied, which is cheaper than
+ *  copying the entire struct.
+ */
+void ffx_hash_cloneKeccak256(FfxKeccak256Context *context,
+  const FfxKeccak256Context *source);
+
+/**
+ *  Initialize %%prefix%% by absorbing %%data%%, for use with
+ *  [[ffx_hash_initKeccak256WithPrefix]] and
+ *  [[ffx_hash_keccak256WithPrefix]].
+ *
+ *  Examples: the EIP-191 "\x19Ethereum Signed Message:\n", the EIP-712
+ *  "\x19\x01" || domainSeparator or the CREATE2 0xff || deployer.
+ */
+void ffx_hash_initKeccak256Prefix(FfxKeccak256Prefix *prefix,
+  const uint8_t *data, size_t length);
+
+/**
+ *  Initialize %%context%% to the state after absorbing %%prefix%%.
+ */
+void ffx_hash_initKeccak256WithPrefix(FfxKeccak256Context *context,
+  const FfxKeccak256Prefix *prefix);
+
+/**
+ *  Computes the Keccak256 digest of %%prefix%% || %%data%%.
+ */
+void ffx_hash_keccak256WithPrefix(uint8_t *digest,
+  const FfxKeccak256Prefix *prefix, const uint8_t *data, size_t length);
+
+/**
+ *  Computes the Keccak256 digest of exactly 32, 40 or 64 bytes of
+ *  %%data%%.
+ *
+ *  These fit in a single block, so the padded block is built directly
+ *  in the state and only one permutation is required. Used for hashing
+ *  digests, checksum addresses and public keys respectively.
+ */
+void ffx_hash_keccak256_32(uint8_t *digest, const uint8_t *data);
+void ffx_hash_keccak256_40(uint8_t *digest, const uint8_t *data);
+void ffx_hash_keccak256_64(uint8_t *digest, const uint8_t *data);
+
+/**
+ *  Computes the Keccak256 digest of each of the %%count%% independent
+ *  messages in %%inputs%% (with lengths %%lengths%%), writing the
+ *  digests consecutively to %%digests%%, which must be
+ *  %%count%% * [[FFX_KECCAK256_DIGEST_LENGTH]] bytes.
+ *
+ *  On hosts with SIMD support, several messages are hashed in parallel,
+ *  which is most effective when the messages are of similar length.
+ */
+void ffx_hash_keccak256Batch(uint8_t *digests, const uint8_t * const *inputs,
+  const size_t *lengths, size_t count);
+
+/**
+ *  Computes the RIPEMD-160 digest of %%data%%, which is only used (after
+ *  SHA-256, as hash160) for BIP-32 key fingerprints.
+ */
+void ffx_hash_ripemd160(uint8_t *digest, const uint8_t *data, size_t length);
+
+
+/**
+ *  The implementations available for a hash function.
+ *
+ *  Hardware backends are only available on hosts which support them;
+ *  the portable implementation is always available.
+ */
+typedef enum FfxHashBackend {
+    // Select the best backend for the running CPU
+    FfxHashBackendAuto = 0,
+
+    FfxHashBackendPortable,
+
+    // x86-64 SHA extensions (SHA-256)
+    FfxHashBackendShaNi,
+} FfxHashBackend;
+
+/**
+ *  Returns the backend used for SHA-256, which is selected on first
+ *  use unless forced with [[ffx_hash_setSha256Backend]].
+ */
+FfxHashBackend ffx_hash_getSha256Backend(void);
+
+/**
+ *  Forces the SHA-256 %%backend%%, such as to benchmark or test the
+ *  portable implementation on a host with SHA extensions. Use
+ *  FfxHashBackendAuto to restore the default.
+ *
+ *  The backend is process-global, so this must not be called while any
+ *  thread is hashing (a hash in progress may otherwise mix backends).
+ *
+ *  Returns false (leaving the backend unchanged) if %%backend%% is not
+ *  supported by the running CPU.
+ */
+bool ffx_hash_setSha256Backend(FfxHashBackend backend);
 
 void ffx_hash_initSha256(FfxSha256Context *context);
 void ffx_hash_updateSha256(FfxSha256Context *context, const uint8_t *data,
   size_t length);
 void ffx_hash_finalSha256(FfxSha256Context *context, uint8_t *digest);
+void ffx_hash_updateSegmentsSha256(FfxSha256Context *context,
+  const FfxHashSegment *segments, size_t count);
 void ffx_hash_sha256(uint8_t *digest, const uint8_t *data, size_t length);
 
+/**
+ *  Computes the SHA-256 digest of each of the %%count%% independent
+ *  messages in %%inputs%% (with lengths %%lengths%%), writing the
+ *  digests consecutively to %%digests%%, which must be
+ *  %%count%% * [[FFX_SHA256_DIGEST_LENGTH]] bytes.
+ *
+ *  On hosts with SIMD support, up to 8 messages are hashed in parallel,
+ *  which is most effective for short messages of similar length (such
+ *  as BIP-39 checksums of candidate entropies).
+ */
+void ffx_hash_sha256Batch(uint8_t *digests, const uint8_t * const *inputs,
+  const size_t *lengths, size_t count);
+
 void ffx_hmac_initSha256(FfxHmacSha256Context *context,
   const uint8_t *key, size_t length);
 void ffx_hmac_updateSha256(FfxHmacSha256Context *context,
@@ -86,10 +294,35 @@ void ffx_hmac_finalSha256(FfxHmacSha256Context *context, uint8_t *hmac);
 void ffx_hmac_sha256(uint8_t *digest, const uint8_t *key, size_t keyLen,
   const uint8_t *data, size_t dataLen);
 
+/**
+ *  Initialize %%key%% from the HMAC key %%data%%.
+ *
+ *  This performs the two compressions of the padded key, so a key used
+ *  for several messages (such as a PBKDF2 password) should be prepared
+ *  once and used with [[ffx_hmac_initSha256WithKey]], which only copies
+ *  the prepared state.
+ */
+void ffx_hmac_initSha256Key(FfxHmacSha256Key *key, const uint8_t *data,
+  size_t length);
+
+/**
+ *  Initialize %%context%% to compute an HMAC with the prepared %%key%%.
+ */
+void ffx_hmac_initSha256WithKey(FfxHmacSha256Context *context,
+  const FfxHmacSha256Key *key);
+
+/**
+ *  Computes the HMAC-SHA256 of %%data%% with the prepared %%key%%.
+ */
+void ffx_hmac_sha256WithKey(uint8_t *digest, const FfxHmacSha256Key *key,
+  const uint8_t *data, size_t length);
+
 void ffx_hash_initSha512(FfxSha512Context *context);
 void ffx_hash_updateSha512(FfxSha512Context *context, const uint8_t *data,
   size_t length);
 void ffx_hash_finalSha512(FfxSha512Context *context, uint8_t *digest);
+void ffx_hash_updateSegmentsSha512(FfxSha512Context *context,
+  const FfxHashSegment *segments, size_t count);
 void ffx_hash_sha512(uint8_t *digest, const uint8_t *data, size_t length);
 
 void ffx_hmac_initSha512(FfxHmacSha512Context *context,
@@ -100,6 +333,13 @@ void ffx_hmac_finalSha512(FfxHmacSha512Context *context, uint8_t *hmac);
 void ffx_hmac_sha512(uint8_t *digest, const uint8_t *key, size_t keyLen,
   const uint8_t *data, size_t dataLen);
 
+void ffx_hmac_initSha512Key(FfxHmacSha512Key *key, const uint8_t *data,
+  size_t length);
+void ffx_hmac_initSha512WithKey(FfxHmacSha512Context *context,
+  const FfxHmacSha512Key *key);
+void ffx_hmac_sha512WithKey(uint8_t *digest, const FfxHmacSha512Key *key,
+  const uint8_t *data, size_t length);
+
 
 
 void ffx_pbkdf2_sha256(uint8_t *dkOut, size_t dkLength, uint32_t iterations,
@@ -110,6 +350,88 @@ void ffx_pbkdf2_sha512(uint8_t *dkOut, size_t dkLength, uint32_t iterations,
   const uint8_t *passwd, size_t passwdLength,
   const uint8_t *salt, size_t saltLength);
 
+/**
+ *  Computes [[ffx_pbkdf2_sha512]] for each of the %%count%% independent
+ *  %%passwds%% (with lengths %%passwdLengths%%) and %%salts%% (with
+ *  lengths %%saltLengths%%), writing each derived key consecutively to
+ *  %%dkOut%%, which must be %%count%% * %%dkLength%% bytes.
+ *
+ *  On hosts with SIMD support, the iterations of up to 4 computations
+ *  are run in parallel.
+ */
+void ffx_pbkdf2_sha512Batch(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t * const *passwds,
+  const size_t *passwdLengths, const uint8_t * const *salts,
+  const size_t *saltLengths, size_t count);
+
+/**
+ *  Initialize %%context%% to compute [[ffx_pbkdf2_sha256]] incrementally,
+ *  so a long computation can be split into slices (e.g. across
+ *  scheduler ticks) using [[ffx_pbkdf2_stepSha256]].
+ *
+ *  The %%passwd%% is only used during this call, but %%salt%% and
+ *  %%dkOut%% must remain valid until the computation is complete.
+ *
+ *  example:
+ *    FfxPbkdf2Sha512Context ctx;
+ *    ffx_pbkdf2_initSha512(&ctx, seed, 64, 2048, phrase, phraseLength,
+ *      salt, saltLength);
+ *
+ *    // Each tick
+ *    if (ffx_pbkdf2_stepSha512(&ctx, 64)) {
+ *        ffx_pbkdf2_finalSha512(&ctx);
+ *    }
+ */
+void ffx_pbkdf2_initSha256(FfxPbkdf2Sha256Context *context, uint8_t *dkOut,
+  size_t dkLength, uint32_t iterations, const uint8_t *passwd,
+  size_t passwdLength, const uint8_t *salt, size_t saltLength);
+
+/**
+ *  Performs up to %%count%% iterations of %%context%%, writing each block
+ *  of the derived key to %%dkOut%% as it completes.
+ *
+ *  Returns true once every iteration is complete.
+ */
+bool ffx_pbkdf2_stepSha256(FfxPbkdf2Sha256Context *context, uint32_t count);
+
+/**
+ *  Performs any remaining iterations of %%context%% and clears the
+ *  key material from it.
+ */
+void ffx_pbkdf2_finalSha256(FfxPbkdf2Sha256Context *context);
+
+/**
+ *  Returns the number of iterations completed, and if %%total%% is
+ *  not NULL, sets it to the total number of iterations (which is
+ *  %%iterations%% for each block of the derived key).
+ */
+uint32_t ffx_pbkdf2_getProgressSha256(const FfxPbkdf2Sha256Context *context,
+  uint32_t *total);
+
+/**
+ *  Computes [[ffx_pbkdf2_sha256]], calling %%progress%% with %%arg%%
+ *  after each %%interval%% iterations (and on completion).
+ *
+ *  Returns false if %%progress%% cancelled the computation, in which
+ *  case %%dkOut%% is incomplete.
+ */
+bool ffx_pbkdf2_sha256WithProgress(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t *passwd, size_t passwdLength,
+  const uint8_t *salt, size_t saltLength, uint32_t interval,
+  FfxPbkdf2ProgressFunc progress, void *arg);
+
+void ffx_pbkdf2_initSha512(FfxPbkdf2Sha512Context *context, uint8_t *dkOut,
+  size_t dkLength, uint32_t iterations, const uint8_t *passwd,
+  size_t passwdLength, const uint8_t *salt, size_t saltLength);
+bool ffx_pbkdf2_stepSha512(FfxPbkdf2Sha512Context *context, uint32_t count);
+void ffx_pbkdf2_finalSha512(FfxPbkdf2Sha512Context *context);
+uint32_t ffx_pbkdf2_getProgressSha512(const FfxPbkdf2Sha512Context *context,
+  uint32_t *total);
+bool ffx_pbkdf2_sha512WithProgress(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t *passwd, size_t passwdLength,
+  const uint8_t *salt, size_t saltLength, uint32_t interval,
+  FfxPbkdf2ProgressFunc progress, void *arg);
+
 
 #ifdef __cplusplus
 }
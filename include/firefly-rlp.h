@@ -2,6 +2,7 @@
 #define __FIREFLY_RLP_H__
 
 #include "firefly-data.h"
+#include "firefly-hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,11 +44,34 @@ typedef struct FfxRlpIterator {
     FfxDataError error;
 } FfxRlpIterator;
 
+/**
+ *  The maximum Array nesting depth supported while measuring.
+ */
+#define FFX_RLP_MAX_DEPTH          (8)
+
+typedef enum FfxRlpBuilderMode {
+    FfxRlpBuilderModeBuild = 0,
+    FfxRlpBuilderModeMeasure,
+    FfxRlpBuilderModeStream
+} FfxRlpBuilderMode;
+
 typedef struct FfxRlpBuilder {
     uint8_t *data;
     size_t offset, length;
 
     FfxDataError error;
+
+    // Measuring and streaming; see ffx_rlp_buildMeasure
+    FfxRlpBuilderMode _mode;
+    FfxKeccak256Context *_sink;
+    size_t *_arrayLengths;
+    size_t _arrayCount, _arrayIndex;
+
+    size_t _depth;
+    struct {
+        size_t index;
+        size_t remaining;
+    } _open[FFX_RLP_MAX_DEPTH];
 } FfxRlpBuilder;
 
 typedef size_t FfxRlpBuilderTag;
@@ -133,18 +157,88 @@ bool ffx_rlp_appendData(FfxRlpBuilder *builder, const uint8_t *data,
  */
 bool ffx_rlp_appendString(FfxRlpBuilder *builder, const char *data);
 
+/**
+ *  Append an already RLP-encoded item, such as a nested structure
+ *  which was built separately.
+ *
+ *  The %%data%% must be exactly one item, which is not validated.
+ */
+bool ffx_rlp_appendRlp(FfxRlpBuilder *builder, const uint8_t *data,
+  size_t length);
+
 /**
  *  Append an Array, where the next %%count%% Items added will be
  *  added to this array.
  */
 bool ffx_rlp_appendArray(FfxRlpBuilder *builder, size_t count);
 
+/**
+ *  Append an Array whose count is not yet known, which must be updated
+ *  with [[ffx_rlp_adjustCount]] as children are added.
+ *
+ *  Mutable Arrays require [[ffx_rlp_finalize]], so are not supported
+ *  when measuring or streaming.
+ */
 FfxRlpBuilderTag ffx_rlp_appendMutableArray(FfxRlpBuilder *builder);
 
 bool ffx_rlp_adjustCount(FfxRlpBuilder *builder, FfxRlpBuilderTag tag,
   size_t count);
 
 
+///////////////////////////////
+// Streaming
+
+/**
+ *  Streaming emits the final RLP-encoded bytes as each item is appended,
+ *  rather than back-patching Array headers during [[ffx_rlp_finalize]].
+ *  This allows hashing the encoded data as it is produced, without a
+ *  second pass over it and optionally without keeping it in memory.
+ *
+ *  Since each Array header includes the byte length of its children,
+ *  the structure is first built with a measuring builder, which records
+ *  the length of each (non-empty) Array in the order they are appended.
+ *  The identical structure is then built again with a streaming builder
+ *  which uses those lengths.
+ *
+ *  example:
+ *    size_t lengths[16];
+ *    FfxRlpBuilder rlp = ffx_rlp_buildMeasure(lengths, 16);
+ *    build(&rlp);
+ *    size_t count = ffx_rlp_getMeasuredArrayCount(&rlp);
+ *
+ *    FfxKeccak256Context ctx;
+ *    ffx_hash_initKeccak256(&ctx);
+ *    rlp = ffx_rlp_buildStream(NULL, 0, &ctx, lengths, count);
+ *    build(&rlp);
+ *    ffx_hash_finalKeccak256(&ctx, digest);
+ */
+
+/**
+ *  Initializes a builder which only measures, storing the byte length
+ *  of each Array in %%arrayLengths%%, which has room for %%count%%
+ *  Arrays.
+ *
+ *  Arrays must be appended with their final count and nested no deeper
+ *  than [[FFX_RLP_MAX_DEPTH]].
+ */
+FfxRlpBuilder ffx_rlp_buildMeasure(size_t *arrayLengths, size_t count);
+
+/**
+ *  Returns the number of Array lengths recorded by a measuring builder.
+ */
+size_t ffx_rlp_getMeasuredArrayCount(FfxRlpBuilder *builder);
+
+/**
+ *  Initializes a builder which emits the encoded data as items are
+ *  appended to %%sink%% (if non-NULL) and to %%data%% (if non-NULL),
+ *  using the %%arrayLengths%% from a measuring builder.
+ *
+ *  The data is complete as it is appended, so finalize is not required.
+ */
+FfxRlpBuilder ffx_rlp_buildStream(uint8_t *data, size_t length,
+  FfxKeccak256Context *sink, const size_t *arrayLengths, size_t count);
+
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,112 @@
+#ifndef __FIREFLY_TRIE_H__
+#define __FIREFLY_TRIE_H__
+
+#include "firefly-data.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ *  Ordered Merkle-Patricia Trie Root
+ *
+ *  Computes the root of a trie whose keys are the RLP-encoded index of
+ *  each item in an ordered list, which is used for the transactionsRoot,
+ *  receiptsRoot and withdrawalsRoot of a block header.
+ *
+ *  Items are added in index order, in a single pass. Each completed
+ *  subtrie is hashed as soon as it can no longer change, so only the
+ *  rightmost path of the trie is kept, and memory is bounded regardless
+ *  of the number of items.
+ *
+ *  example:
+ *    FfxOrderedTrie trie;
+ *    ffx_trie_init(&trie);
+ *    for (size_t i = 0; i < count; i++) {
+ *        ffx_trie_append(&trie, items[i], itemLengths[i]);
+ *    }
+ *    uint8_t root[FFX_TRIE_ROOT_LENGTH];
+ *    ffx_trie_getRoot(&trie, root);
+ */
+
+#define FFX_TRIE_ROOT_LENGTH           (32)
+
+// RLP(index) for a 32-bit index is at most 5 bytes
+#define FFX_TRIE_MAX_KEY_NIBBLES       (10)
+
+// At most 16 node references are pending per level
+#define FFX_TRIE_MAX_STACK             (16 * FFX_TRIE_MAX_KEY_NIBBLES)
+
+/**
+ *  A reference to a node; its RLP-encoding if shorter than 32 bytes,
+ *  otherwise the RLP-encoding of its hash.
+ */
+typedef struct FfxTrieNodeRef {
+    uint8_t length;
+    uint8_t data[33];
+} FfxTrieNodeRef;
+
+/**
+ *  This should not be modified directly! Only use the provided API.
+ */
+typedef struct FfxOrderedTrie {
+    size_t count;
+
+    // The item at index 0 (key 0x80) sorts after indices 1 through 127
+    // so it is held until then
+    const uint8_t *first;
+    size_t firstLength;
+
+    // The most recently inserted leaf; its node depends on the next key
+    uint8_t key[FFX_TRIE_MAX_KEY_NIBBLES];
+    size_t keyLength;
+    const uint8_t *value;
+    size_t valueLength;
+
+    // The children present at each depth along the rightmost path
+    uint16_t groups[FFX_TRIE_MAX_KEY_NIBBLES];
+    size_t groupCount;
+
+    FfxTrieNodeRef stack[FFX_TRIE_MAX_STACK];
+    size_t stackCount;
+
+    FfxDataError error;
+} FfxOrderedTrie;
+
+
+/**
+ *  Initialize %%trie%%.
+ */
+void ffx_trie_init(FfxOrderedTrie *trie);
+
+/**
+ *  Appends the next %%item%% (the encoded transaction, receipt, etc.).
+ *
+ *  The %%item%% is not copied, and must remain valid until the next item
+ *  is appended. The item at index 0 must remain valid until the item at
+ *  index 128 is appended or the root is computed.
+ *
+ *  Returns false on error.
+ */
+bool ffx_trie_append(FfxOrderedTrie *trie, const uint8_t *item,
+  size_t length);
+
+/**
+ *  Writes the root hash of %%trie%% to %%rootOut%%, which must be
+ *  [[FFX_TRIE_ROOT_LENGTH]] bytes. No further items may be appended.
+ *
+ *  Returns false on error.
+ */
+bool ffx_trie_getRoot(FfxOrderedTrie *trie, uint8_t *rootOut);
+
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __FIREFLY_TRIE_H__ */
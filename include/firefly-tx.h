@@ -18,6 +18,20 @@ FfxDataResult ffx_tx_init(uint8_t *rlp, size_t length);
 FfxDataResult ffx_tx_serializeUnsigned(FfxCborCursor tx, uint8_t *data,
   size_t length);
 
+/**
+ *  Computes the signing digest of the unsigned %%tx%%, hashing the
+ *  serialized data as it is produced rather than serializing it to a
+ *  buffer first.
+ *
+ *  Each access list entry is measured and streamed on its own, so the
+ *  stack used does not depend on the number of entries. An access list
+ *  (or slot list) whose declared count exceeds the remaining data fails
+ *  with FfxDataErrorOverflow.
+ *
+ *  The %%digestOut%% must be [[FFX_KECCAK256_DIGEST_LENGTH]] bytes.
+ */
+FfxDataError ffx_tx_getUnsignedDigest(FfxCborCursor tx, uint8_t *digestOut);
+
 
 //FfxDataResult ffx_tx_serializeSigned(FfxCborCursor *tx, uint8_t *signature);
 
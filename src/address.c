@@ -26,7 +26,7 @@ FfxChecksumAddress ffx_eth_checksumAddress(const FfxAddress *address) {
 
     // Hash the ASCII representation
     uint8_t digest[FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
-    ffx_hash_keccak256(digest, (const uint8_t*)checksumOut, 40);
+    ffx_hash_keccak256_40(digest, (const uint8_t*)checksumOut);
 
     // Uppercase any (alpha) nibble if the coresponding hash nibble >= 8
     for (int i = 0; i < 40; i += 2) {
@@ -41,12 +41,14 @@ FfxChecksumAddress ffx_eth_checksumAddress(const FfxAddress *address) {
         }
     }
 
+    checksumOut[40] = '\0';
+
     return result;
 }
 
 FfxAddress ffx_eth_getAddress(const FfxEcPubkey *pubkey) {
     uint8_t hashed[32];
-    ffx_hash_keccak256(hashed, &pubkey->data[1], 64);
+    ffx_hash_keccak256_64(hashed, &pubkey->data[1]);
 
     FfxAddress result;
     memcpy(result.data, &hashed[12], 20);
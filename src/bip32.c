@@ -1,74 +1,436 @@
 #include <string.h>
 
 #include "firefly-bip32.h"
+#include "firefly-address.h"
 #include "firefly-ecc.h"
 #include "firefly-hash.h"
 
-#include "bip39-en.h"
+#include "bip39-wordlists.h"
 
 // DEBUG
 #include <stdio.h>
 void dumpBuffer(const char*, const uint8_t*, size_t);
 
-#define WORDLIST            wordlist_en
-
 // "Bitcoin seed"
 const uint8_t MasterSecret[] = { 66, 105, 116, 99, 111, 105, 110, 32, 115, 101, 101, 100 };
 
 
-static bool nextWord(FfxWordlistCursor *cursor) {
-    if (cursor->index >= 2047) { return false; }
+///////////////////////////////
+// Wordlists
+//
+// See db/export-bip39.mjs for the format; these MUST match it.
 
-    if (cursor->length != 0) {
-        cursor->index++;
-        cursor->offset += cursor->length + 1;
+#define WORDLIST_COUNT \
+    (sizeof(_ffx_bip39_wordlists) / sizeof(_ffx_bip39_wordlists[0]))
+
+static const Wordlist* getWordlist(FfxBip39Language language) {
+    if (language < 0 || language >= WORDLIST_COUNT) { return NULL; }
+    const Wordlist *wordlist = &_ffx_bip39_wordlists[language];
+    return wordlist->data ? wordlist: NULL;
+}
+
+// Reads 8 bytes little-endian
+static uint64_t readLe64(const uint8_t *data) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+#else
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; i--) { value = (value << 8) | data[i]; }
+    return value;
+#endif
+}
+
+// Writes 8 bytes little-endian
+static void writeLe64(uint8_t *data, uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(data, &value, sizeof(value));
+#else
+    for (int i = 0; i < 8; i++) { data[i] = value >> (8 * i); }
+#endif
+}
+
+// The location of a word in the data
+typedef struct WordRef {
+    size_t length;
+
+    // The group prefix, which is omitted from the data
+    size_t prefix;
+    uint32_t prefixBytes;
+
+    // The offset of the rest of the word
+    size_t offset;
+} WordRef;
+
+// Returns the location of the word at %%index%% (which must be in the
+// range [0, 2047])
+static inline WordRef findWord(const Wordlist *wordlist, size_t index) {
+    size_t group = index / WORDLIST_GROUP_SIZE;
+
+    WordRef ref;
+    ref.prefix = wordlist->prefixes[group];
+    ref.prefixBytes = wordlist->prefixBytes[group];
+    ref.offset = wordlist->offsets[index];
+    ref.length = ref.prefix + wordlist->offsets[index + 1] - ref.offset;
+
+    return ref;
+}
+
+static size_t getLength(const Wordlist *wordlist, int index) {
+    return findWord(wordlist, index).length;
+}
+
+// Returns true if the word at %%ref%% fits in a single getShortWord
+static bool isShortWord(const WordRef *ref) {
+    return ref->length <= 8;
+}
+
+static const uint64_t PrefixScales[] = {
+    1, 1 << 8, 1 << 16, 1 << 24, 1ULL << 32
+};
+static const uint64_t LengthMasks[] = {
+    0, 0xff, 0xffff, 0xffffff, 0xffffffff, 0xffffffffffULL,
+    0xffffffffffffULL, 0xffffffffffffffULL, 0xffffffffffffffffULL
+};
+
+// Returns the bytes of the short word at %%ref%% (little-endian and zero
+// padded), joining the prefix and the rest of the word with a single load
+static inline uint64_t getShortWord(const Wordlist *wordlist,
+  const WordRef *ref) {
+
+    uint64_t v = readLe64(&wordlist->data[ref->offset]);
+    v = (v * PrefixScales[ref->prefix]) | ref->prefixBytes;
+
+    return v & LengthMasks[ref->length];
+}
+
+// Writes the word at %%ref%% which is not a short word (see writeWord)
+static size_t writeLongWord(const Wordlist *wordlist, const WordRef *ref,
+  char *wordOut) {
+
+    for (int i = 0; i < ref->prefix; i++) {
+        wordOut[i] = ref->prefixBytes >> (8 * i);
     }
 
-    cursor->length = strlen(&WORDLIST[cursor->offset]);
+    memcpy(&wordOut[ref->prefix], &wordlist->data[ref->offset],
+      ref->length - ref->prefix);
 
-    return true;
+    wordOut[ref->length] = 0;
+
+    return ref->length;
+}
+
+// Writes the NULL-terminated word at %%ref%% to %%wordOut%%, returning
+// its length; %%wordOut%% must be at least WORDLIST_MAX_WORD_LENGTH
+// bytes, as it may be written past the NULL-terminator
+static inline size_t writeWord(const Wordlist *wordlist, const WordRef *ref,
+  char *wordOut) {
+
+    if (!isShortWord(ref)) { return writeLongWord(wordlist, ref, wordOut); }
+
+    // The zero padding NULL-terminates all but 8-byte words
+    writeLe64((uint8_t*)wordOut, getShortWord(wordlist, ref));
+    wordOut[8] = 0;
+
+    return ref->length;
+}
+
+// Writes the NULL-terminated word at %%index%% (which must be in the
+// range [0, 2047]) to %%wordOut%% (see writeWord), returning its length
+static size_t getWord(const Wordlist *wordlist, int index, char *wordOut) {
+    WordRef ref = findWord(wordlist, index);
+    return writeWord(wordlist, &ref, wordOut);
+}
+
+// The word index is a perfect hash over a hash of each word, 8 bytes at
+// a time, so a lookup only needs to compare against a single candidate
+// word; most words are a single 8-byte chunk, which is also compared
+// at once
+
+// Reads 4 bytes little-endian
+static uint32_t readLe32(const uint8_t *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) |
+      ((uint32_t)data[3] << 24);
+}
+
+// Returns the first %%length%% (at most 8) bytes of %%data%% little-endian
+// and zero padded, without a branch per byte, as the length of each
+// word in a phrase is unpredictable
+static uint64_t readChunk(const char *_data, size_t length) {
+    const uint8_t *data = (const uint8_t*)_data;
+
+    if (length >= 8) { return readLe64(data); }
+
+    // Two (possibly overlapping) 4-byte reads
+    if (length >= 4) {
+        return readLe32(data) |
+          ((uint64_t)readLe32(&data[length - 4]) << (8 * (length - 4)));
+    }
+
+    if (length == 0) { return 0; }
+
+    // Three (possibly overlapping) 1-byte reads
+    return data[0] | (data[length / 2] << (8 * (length / 2))) |
+      (data[length - 1] << (8 * (length - 1)));
+}
+
+static uint32_t getKey(const char* word, size_t length) {
+    uint64_t key = length;
+    for (size_t i = 0; i < length; i += 8) {
+        size_t count = (length - i < 8) ? (length - i): 8;
+        key = (key ^ readChunk(&word[i], count)) * 0x9e3779b97f4a7c15ULL;
+        key ^= key >> 32;
+    }
+    return key;
+}
+
+static uint32_t hashKey(uint32_t key, uint32_t seed) {
+    uint32_t h = (key ^ (seed * 0x9e3779b9)) * 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    return h ^ (h >> 16);
+}
+
+static int wordToIndex(const Wordlist *wordlist, const char* const word,
+  size_t length) {
+
+    if (length == 0 || length >= WORDLIST_MAX_WORD_LENGTH) { return -1; }
+
+    uint32_t key = getKey(word, length);
+    uint32_t bucket = hashKey(key, 0) % WORDLIST_BUCKET_COUNT;
+    int index = wordlist->slots[hashKey(key, wordlist->seeds[bucket]) % 2048];
+
+    WordRef ref = findWord(wordlist, index);
+    if (ref.length != length) { return -1; }
+
+    if (isShortWord(&ref)) {
+        if (getShortWord(wordlist, &ref) != readChunk(word, length)) {
+            return -1;
+        }
+        return index;
+    }
+
+    char candidate[WORDLIST_MAX_WORD_LENGTH];
+    getWord(wordlist, index, candidate);
+    if (memcmp(word, candidate, length)) { return -1; }
+
+    return index;
+}
+
+// Prefix lookups binary search the words in byte order, within the
+// range of words sharing the first byte
+
+static int getSortedIndex(const Wordlist *wordlist, int position) {
+    return wordlist->sorted ? wordlist->sorted[position]: position;
+}
+
+// Compares the word at %%position%% (in byte order), truncated to
+// %%length%% bytes, against %%prefix%%
+static int comparePrefix(const Wordlist *wordlist, int position,
+  const char *prefix, size_t length) {
+
+    char word[WORDLIST_MAX_WORD_LENGTH];
+    size_t wordLength = getWord(wordlist, getSortedIndex(wordlist, position),
+      word);
+
+    int result = memcmp(word, prefix,
+      (wordLength < length) ? wordLength: length);
+    if (result) { return result; }
+
+    // A word shorter than the prefix sorts before it
+    return (wordLength < length) ? -1: 0;
 }
 
-static int wordToIndex(const char* const word, size_t length) {
-    FfxWordlistCursor cursor = { 0 };
+// Returns the first position in [lo, hi) which compares to %%prefix%%
+// as greater than (or equal to, if %%inclusive%%)
+static int searchPrefix(const Wordlist *wordlist, int lo, int hi,
+  const char *prefix, size_t length, bool inclusive) {
 
-    while (nextWord(&cursor)) {
-        if (length != cursor.length) { continue; }
-        if (!strncmp(word, &WORDLIST[cursor.offset], length)) {
-            return cursor.index;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int result = comparePrefix(wordlist, mid, prefix, length);
+        if (result < 0 || (result == 0 && !inclusive)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    return lo;
+}
+
+static size_t getPrefixRange(const Wordlist *wordlist, const char *prefix,
+  size_t length, int *startOut) {
+
+    if (length == 0) {
+        *startOut = 0;
+        return 2048;
+    }
+
+    int b = (uint8_t)prefix[0] - wordlist->firstByte;
+    if (b < 0 || b >= wordlist->startCount - 1) {
+        *startOut = 0;
+        return 0;
+    }
+
+    int lo = wordlist->starts[b], hi = wordlist->starts[b + 1];
+
+    int start = searchPrefix(wordlist, lo, hi, prefix, length, true);
+    int end = searchPrefix(wordlist, start, hi, prefix, length, false);
+
+    *startOut = start;
+    return end - start;
+}
+
+bool ffx_bip39_hasLanguage(FfxBip39Language language) {
+    return (getWordlist(language) != NULL);
+}
+
+int ffx_bip39_getIndex(FfxBip39Language language, const char* word,
+  size_t length) {
+
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL) { return -1; }
+    return wordToIndex(wordlist, word, length);
+}
+
+size_t ffx_bip39_getWord(FfxBip39Language language, int index,
+  char *wordOut) {
+
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL || index < 0 || index > 2047) {
+        wordOut[0] = 0;
+        return 0;
+    }
+    return getWord(wordlist, index, wordOut);
+}
+
+size_t ffx_bip39_getPrefixRange(FfxBip39Language language,
+  const char* prefix, size_t length, int *startOut) {
+
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL) {
+        *startOut = 0;
+        return 0;
+    }
+    return getPrefixRange(wordlist, prefix, length, startOut);
+}
+
+int ffx_bip39_getSortedIndex(FfxBip39Language language, int position) {
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL || position < 0 || position > 2047) { return -1; }
+    return getSortedIndex(wordlist, position);
+}
+
+size_t ffx_bip39_getUniquePrefixLength(FfxBip39Language language,
+  int index) {
+
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL || index < 0 || index > 2047) { return 0; }
+
+    char word[WORDLIST_MAX_WORD_LENGTH];
+    size_t wordLength = getWord(wordlist, index, word);
+
+    // The shortest prefix matching only this word (and any words it is
+    // itself a prefix of, which no shorter prefix can exclude)
+    size_t length = 1;
+    for (; length < wordLength; length++) {
+        int start;
+        if (getPrefixRange(wordlist, word, length, &start) == 1) { break; }
+    }
+
+    // Do not split a UTF-8 character
+    while (length < wordLength && (word[length] & 0xc0) == 0x80) {
+        length++;
+    }
 
-    return -1;
+    return length;
 }
 
 int ffx_bip39_index(const char* const word) {
-    return wordToIndex(word, strlen(word));
+    return ffx_bip39_getIndex(FfxBip39LanguageEnglish, word, strlen(word));
 }
 
+// The deprecated API returns the word in a static buffer
+static char deprecatedWord[WORDLIST_MAX_WORD_LENGTH];
+
 const char* ffx_bip39_word(int index) {
-    FfxWordlistCursor cursor = { 0 };
+    if (!ffx_bip39_getWord(FfxBip39LanguageEnglish, index, deprecatedWord)) {
+        return NULL;
+    }
+    return deprecatedWord;
+}
 
-    while (nextWord(&cursor)) {
-        if (cursor.index == index) { return &WORDLIST[cursor.offset]; }
+static const char* nextWord(FfxWordlistCursor *cursor, int *index) {
+    // The offset is that of the word in the NULL-separated strings
+    if (cursor->length != 0) {
+        cursor->index++;
+        cursor->offset += cursor->length + 1;
+    }
+
+    cursor->length = ffx_bip39_getWord(FfxBip39LanguageEnglish,
+      cursor->index, deprecatedWord);
+    if (cursor->length == 0) {
+        if (index) { *index = -1; }
+        return NULL;
     }
 
-    return NULL;
+    if (index) { *index = cursor->index; }
+    return deprecatedWord;
 }
 
 const char* ffx_bip39_nextWord(FfxWordlistCursor *cursor, int *index) {
-    if (!nextWord(cursor)) {
-        *index = -1;
-        return NULL;
+    return nextWord(cursor, index);
+}
+
+const char* ffx_bipd39_nextWord(FfxWordlistCursor *cursor, int *index) {
+    return nextWord(cursor, index);
+}
+
+
+///////////////////////////////
+// Mnemonic
+
+// Returns the length of the whitespace (including the ideographic space
+// used by Japanese phrases) at %%phrase%%, or 0 if not whitespace
+static inline size_t getSpace(const char* phrase) {
+    char c = phrase[0];
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') { return 1; }
+    // U+3000 (which stops at a NULL-terminator before reading past it)
+    if (c == '\xe3' && phrase[1] == '\x80' && phrase[2] == '\x80') {
+        return 3;
     }
+    return 0;
+}
 
-    if (index) { *index = cursor->index; }
-    return &WORDLIST[cursor->offset];
+// Sets the 11 bits of the word at %%position%% in %%entropy%% (which
+// must be cleared) to %%index%%
+static void setWordIndex(uint8_t *entropy, int position, int index) {
+    int bit = position * 11;
+
+    for (int b = 0; b < 11; b++) {
+        if (index & (0b10000000000 >> b)) {
+            entropy[bit / 8] |= (0x80 >> (bit % 8));
+        }
+        bit++;
+    }
 }
 
-bool ffx_mnemonic_initPhrase(FfxMnemonic *mnemonic, const char* phrase) {
+// Returns the mask of the checksum bits (in the byte following the
+// entropy) for %%entropyLength%%
+static uint8_t getChecksumMask(size_t entropyLength) {
+    int bits = (8 * entropyLength / 32);
+    return ((1 << bits) - 1) << (8 - bits);
+}
+
+bool ffx_mnemonic_initPhraseWithLanguage(FfxMnemonic *mnemonic,
+  const char* phrase, FfxBip39Language language) {
+
     memset(mnemonic, 0, sizeof(FfxMnemonic));
 
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL) { return false; }
+
     size_t length = strlen(phrase);
 
     size_t wordCount = 0;
@@ -76,22 +438,18 @@ bool ffx_mnemonic_initPhrase(FfxMnemonic *mnemonic, const char* phrase) {
     bool lastws = true;
     size_t wordStart = 0;
     for (int i = 0; i < 1 + length; i++) {
-        char c = phrase[i];
-        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\0') {
+        size_t space = (phrase[i] == '\0') ? 1: getSpace(&phrase[i]);
+        if (space) {
+            i += space - 1;
+
             if (lastws) { continue; }
             lastws = true;
 
-            int index = wordToIndex(&phrase[wordStart], i - wordStart);
+            int index = wordToIndex(wordlist, &phrase[wordStart],
+              i + 1 - space - wordStart);
             if (index == -1) { return false; }
 
-            int bit = wordCount * 11;
-
-            for (int b = 0; b < 11; b++) {
-                if (index & (0b10000000000 >> b)) {
-                    mnemonic->entropy[bit / 8] |= (0x80 >> (bit % 8));
-                }
-                bit++;
-            }
+            setWordIndex(mnemonic->entropy, wordCount, index);
 
             wordCount++;
         } else {
@@ -107,18 +465,23 @@ bool ffx_mnemonic_initPhrase(FfxMnemonic *mnemonic, const char* phrase) {
     uint8_t digest[FFX_SHA256_DIGEST_LENGTH];
     ffx_hash_sha256(digest, mnemonic->entropy, entropyLength);
 
-    int bits = (8 * entropyLength / 32);
-    int mask = ((1 << bits) - 1) << (8 - bits);
+    uint8_t mask = getChecksumMask(entropyLength);
     if ((mnemonic->entropy[entropyLength] & mask) != (digest[0] & mask)) {
         return false;
     }
 
     mnemonic->wordCount = wordCount;
     mnemonic->entropyLength = entropyLength;
+    mnemonic->language = language;
 
     return true;
 }
 
+bool ffx_mnemonic_initPhrase(FfxMnemonic *mnemonic, const char* phrase) {
+    return ffx_mnemonic_initPhraseWithLanguage(mnemonic, phrase,
+      FfxBip39LanguageEnglish);
+}
+
 bool ffx_mnemonic_initEntropy(FfxMnemonic *mnemonic, const uint8_t* entropy,
   size_t length) {
     memset(mnemonic, 0, sizeof(FfxMnemonic));
@@ -134,58 +497,100 @@ bool ffx_mnemonic_initEntropy(FfxMnemonic *mnemonic, const uint8_t* entropy,
     uint8_t digest[FFX_SHA256_DIGEST_LENGTH];
     ffx_hash_sha256(digest, mnemonic->entropy, length);
 
-    int bits = (8 * length / 32);
-    int mask = ((1 << bits) - 1) << (8 - bits);
-    mnemonic->entropy[length] = digest[0] & mask;
+    mnemonic->entropy[length] = digest[0] & getChecksumMask(length);
 
     return true;
 }
 
-const char* ffx_mnemonic_getWord(FfxMnemonic *mnemonic, int index) {
-    if (index < 0 || index >= mnemonic->wordCount) { return NULL; }
+// Returns the word index of the word at %%index%% in %%mnemonic%%
+static int getWordIndex(FfxMnemonic *mnemonic, int index) {
+    size_t bit = index * 11;
+    const uint8_t *data = &mnemonic->entropy[bit / 8];
 
-    int wordIndex = 0;
-    for (int i = 0; i < 11; i++) {
-        size_t bit = (index * 11) + i;
-        wordIndex <<= 1;
-        if (mnemonic->entropy[bit / 8] & (0x80 >> (bit % 8))) {
-            wordIndex |= 1;
-        }
-    }
+    // The 11 bits span 2 or 3 bytes; only read the third if required,
+    // as the last word ends on the last byte
+    uint32_t value = (data[0] << 16) | (data[1] << 8);
+    if ((bit % 8) > 5) { value |= data[2]; }
+
+    return (value >> (13 - (bit % 8))) & 0x7ff;
+}
+
+bool ffx_mnemonic_setLanguage(FfxMnemonic *mnemonic,
+  FfxBip39Language language) {
+
+    if (getWordlist(language) == NULL) { return false; }
+    mnemonic->language = language;
+    return true;
+}
+
+size_t ffx_mnemonic_getWord(FfxMnemonic *mnemonic, int index,
+  char *wordOut) {
 
-    return ffx_bip39_word(wordIndex);
+    const Wordlist *wordlist = getWordlist(mnemonic->language);
+    if (wordlist == NULL || index < 0 || index >= mnemonic->wordCount) {
+        wordOut[0] = 0;
+        return 0;
+    }
+    return getWord(wordlist, getWordIndex(mnemonic, index), wordOut);
 }
 
 size_t ffx_mnemonic_getPhraseLength(FfxMnemonic *mnemonic) {
+    const Wordlist *wordlist = getWordlist(mnemonic->language);
+    if (wordlist == NULL || mnemonic->wordCount == 0) { return 0; }
+
     size_t length = 0;
     for (int i = 0; i < mnemonic->wordCount; i++) {
-        length += strlen(ffx_mnemonic_getWord(mnemonic, i)) + 1;
+        length += getLength(wordlist, getWordIndex(mnemonic, i));
+        length += strlen(wordlist->separator);
     }
-    return length;
+
+    // The last separator is replaced by the NULL-terminator
+    return length + 1 - strlen(wordlist->separator);
 }
 
 bool ffx_mnemonic_getPhrase(FfxMnemonic *mnemonic, char* phraseOut,
   size_t length) {
 
+    const Wordlist *wordlist = getWordlist(mnemonic->language);
+    if (wordlist == NULL) { return false; }
+
+    const char *separator = wordlist->separator;
+    size_t separatorLength = strlen(separator);
+
     size_t offset = 0;
     for (int i = 0; i < mnemonic->wordCount; i++) {
-        const char* word = ffx_mnemonic_getWord(mnemonic, i);
-        size_t l = strlen(word);
-        if (offset + l + 1 >= length) { return false; }
-        strcpy(&phraseOut[offset], word);
-        offset += l;
-        phraseOut[offset++] = ' ';
+        WordRef ref = findWord(wordlist, getWordIndex(mnemonic, i));
+        if (offset + (i ? separatorLength: 0) + ref.length + 1 > length) {
+            return false;
+        }
+        if (i > 0) {
+            for (int j = 0; j < separatorLength; j++) {
+                phraseOut[offset++] = separator[j];
+            }
+        }
+
+        if (length - offset >= WORDLIST_MAX_WORD_LENGTH) {
+            offset += writeWord(wordlist, &ref, &phraseOut[offset]);
+        } else {
+            // Near the end of phraseOut, which writeWord may write past
+            char word[WORDLIST_MAX_WORD_LENGTH];
+            writeWord(wordlist, &ref, word);
+            memcpy(&phraseOut[offset], word, ref.length);
+            offset += ref.length;
+        }
     }
 
-    phraseOut[offset - 1] = '\0';
+    phraseOut[offset] = '\0';
 
     return true;
 }
 
 static const char saltPrefix[] = "mnemonic";
 
-bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
-  uint8_t *seed) {
+// The number of seeds derived together by getSeedBatch
+#define SEED_BATCH_SIZE        (4)
+
+static bool checkPassword(const char* password) {
     for (int i = strlen(password) - 1; i >= 0; i--) {
         if (password[i] < 32 || password[i] > 126) {
             printf("Unsupported password: '%s' (%d bytes)\n", password,
@@ -193,18 +598,46 @@ bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
             return false;
         }
     }
+    return true;
+}
 
-    char phrase[9 * mnemonic->wordCount];
-    memset(phrase, 0, sizeof(phrase));
+// Returns the length of the phrase used for the seed, which is always
+// space-separated (the NFKD of the ideographic space is a space)
+static size_t getSeedPhraseLength(FfxMnemonic *mnemonic) {
+    const Wordlist *wordlist = getWordlist(mnemonic->language);
+    if (wordlist == NULL) { return 0; }
+
+    size_t length = 0;
+    for (int i = 0; i < mnemonic->wordCount; i++) {
+        if (i > 0) { length++; }
+        length += getLength(wordlist, getWordIndex(mnemonic, i));
+    }
+    return length;
+}
+
+// Writes the space-separated phrase to %%phrase%% (which must be at
+// least getSeedPhraseLength + WORDLIST_MAX_WORD_LENGTH bytes, as each
+// word may be written past its end), returning its length
+static size_t buildPhrase(FfxMnemonic *mnemonic, char *phrase) {
+    const Wordlist *wordlist = getWordlist(mnemonic->language);
 
     size_t offset = 0;
     for (int i = 0; i < mnemonic->wordCount; i++) {
         if (i > 0) { phrase[offset++] = ' '; }
-        const char *word = ffx_mnemonic_getWord(mnemonic, i);
-        size_t wordLength = strlen(word);
-        strcpy(&phrase[offset], word);
-        offset += wordLength;
+        offset += getWord(wordlist, getWordIndex(mnemonic, i), &phrase[offset]);
     }
+    return offset;
+}
+
+bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
+  uint8_t *seed) {
+    if (!checkPassword(password)) { return false; }
+    if (getWordlist(mnemonic->language) == NULL) { return false; }
+
+    char phrase[getSeedPhraseLength(mnemonic) + WORDLIST_MAX_WORD_LENGTH];
+    memset(phrase, 0, sizeof(phrase));
+
+    size_t offset = buildPhrase(mnemonic, phrase);
 
     char salt[strlen(saltPrefix) + strlen(password) + 1];
     memset(salt, 0, sizeof(salt));
@@ -217,10 +650,81 @@ bool ffx_mnemonic_getSeed(FfxMnemonic *mnemonic, const char* password,
     return 1;
 }
 
+bool ffx_mnemonic_getSeedBatch(FfxMnemonic *mnemonics, size_t count,
+  const char* password, uint8_t *seedsOut) {
+    if (!checkPassword(password)) { return false; }
+
+    char salt[strlen(saltPrefix) + strlen(password) + 1];
+    memset(salt, 0, sizeof(salt));
+    strcpy(salt, saltPrefix);
+    strcpy(&salt[strlen(saltPrefix)], password);
+
+    const uint8_t *passwds[SEED_BATCH_SIZE];
+    size_t passwdLengths[SEED_BATCH_SIZE];
+    const uint8_t *salts[SEED_BATCH_SIZE];
+    size_t saltLengths[SEED_BATCH_SIZE];
+
+    for (size_t base = 0; base < count; base += SEED_BATCH_SIZE) {
+        size_t batchCount = count - base;
+        if (batchCount > SEED_BATCH_SIZE) { batchCount = SEED_BATCH_SIZE; }
+
+        size_t maxLength = 1;
+        for (size_t i = 0; i < batchCount; i++) {
+            FfxMnemonic *mnemonic = &mnemonics[base + i];
+            if (mnemonic->wordCount > 24) { return false; }
+            if (getWordlist(mnemonic->language) == NULL) { return false; }
+
+            size_t length = getSeedPhraseLength(mnemonic);
+            if (length > maxLength) { maxLength = length; }
+        }
+
+        char phrases[SEED_BATCH_SIZE][maxLength + WORDLIST_MAX_WORD_LENGTH];
+
+        for (size_t i = 0; i < batchCount; i++) {
+            passwds[i] = (const uint8_t*)phrases[i];
+            passwdLengths[i] = buildPhrase(&mnemonics[base + i], phrases[i]);
+            salts[i] = (const uint8_t*)salt;
+            saltLengths[i] = strlen(salt);
+        }
+
+        ffx_pbkdf2_sha512Batch(&seedsOut[base * FFX_BIP39_SEED_LENGTH],
+          FFX_BIP39_SEED_LENGTH, 2048, passwds, passwdLengths, salts,
+          saltLengths, batchCount);
+    }
+
+    return true;
+}
+
 ///////////////////////////////
 //
 
 
+// Returns the compressed public key of %%node%%, computing it (and
+// memoizing it in %%node%%) for a private node if required, or NULL on
+// failure
+static const FfxEcCompPubkey* getCompPubkey(FfxHDNode *node) {
+    if (node->neutered) { return &node->key.pubkey; }
+
+    if (!node->hasPubkey) {
+        if (!ffx_ec_getCompPubkey(&node->pubkey, &node->key.privkey)) {
+            return NULL;
+        }
+        node->hasPubkey = true;
+    }
+
+    return &node->pubkey;
+}
+
+// Returns the fingerprint (the first 4 bytes of the hash160) of %%pubkey%%
+static uint32_t getFingerprint(const FfxEcCompPubkey *pubkey) {
+    uint8_t digest[FFX_SHA256_DIGEST_LENGTH];
+    ffx_hash_sha256(digest, pubkey->data, sizeof(pubkey->data));
+    ffx_hash_ripemd160(digest, digest, FFX_SHA256_DIGEST_LENGTH);
+
+    return ((uint32_t)digest[0] << 24) | (digest[1] << 16) | (digest[2] << 8) |
+      digest[3];
+}
+
 bool ffx_hdnode_initSeed(FfxHDNode *node, const uint8_t *seed) {
     memset(node, 0, sizeof(FfxHDNode));
 
@@ -228,50 +732,43 @@ bool ffx_hdnode_initSeed(FfxHDNode *node, const uint8_t *seed) {
     ffx_hmac_sha512(I, MasterSecret, sizeof(MasterSecret), seed,
       FFX_BIP39_SEED_LENGTH);
 
-    FfxEcPrivkey privkey;
-    memcpy(privkey.data, I, 32);
-
-    // Check the private key is good
-    FfxEcPubkey pubkey;
-    if (!ffx_ec_getPubkey(&pubkey, &privkey)) { return false; }
-
-    node->key.privkey = privkey;
+    memcpy(node->key.privkey.data, I, 32);
     memcpy(node->chaincode, &I[32], 32);
 
+    // Check the private key is good (memoizing the public key, which
+    // deriving any child requires for the fingerprint)
+    if (getCompPubkey(node) == NULL) {
+        memset(node, 0, sizeof(FfxHDNode));
+        return false;
+    }
+
     return true;
 }
 
-// See: ecc.c
-//void _ffx_pk_modAddSecp256k1(uint8_t *_result, uint8_t *_a, uint8_t *_b);
-//void _ffx_pk_addPointSecp256k1(uint8_t *_result, uint8_t *_a, uint8_t *_b);
-
 bool ffx_hdnode_deriveChild(FfxHDNode *node, uint32_t index) {
     if (node->depth == 0xffffffff) { return false; }
 
+    // The only point multiplication for a private node (if not already
+    // memoized); the child key is validated by the modular addition and
+    // its public key is computed only when required
+    const FfxEcCompPubkey *pubkey = getCompPubkey(node);
+    if (pubkey == NULL) { return false; }
+
     // Used to:
     //  - temporality build up the serI data (37 bytes)
     //  - then hold the hashed value (64 bytes)
     uint8_t I[64] = { 0 };
 
-    if (node->neutered) {
-        // Neutered key derivation
-        if (index & FfxHDNodeHardened) { return false; }
-
-    } else {
-        // Private key derivation
+    if (index & FfxHDNodeHardened) {
+        // Neutered key derivation cannot derive hardened children
+        if (node->neutered) { return false; }
 
-        if (index & FfxHDNodeHardened) {
-            // Data = 0x00 || ser_256(k_par)
-            memcpy(&I[1], node->key.privkey.data, 32);
+        // Data = 0x00 || ser_256(k_par)
+        memcpy(&I[1], node->key.privkey.data, 32);
 
-        } else {
-            // Data = ser_p(point(k_par))
-            FfxEcCompPubkey pubkey;
-            if(!ffx_ec_getCompPubkey(&pubkey, &node->key.privkey)) {
-                return false;
-            }
-            memcpy(I, pubkey.data, 33);
-        }
+    } else {
+        // Data = ser_p(point(k_par))
+        memcpy(I, pubkey->data, 33);
     }
 
     I[33] = (index >> 24) & 0xff;
@@ -279,128 +776,495 @@ bool ffx_hdnode_deriveChild(FfxHDNode *node, uint32_t index) {
     I[35] = (index >>  8) & 0xff;
     I[36] = (index >>  0) & 0xff;
 
-    ffx_hmac_sha512(I, node->chaincode, 32, I, 37);
+    uint32_t fingerprint = getFingerprint(pubkey);
 
-    FfxEcPrivkey IL;
-    memcpy(IL.data, I, 32);
+    ffx_hmac_sha512(I, node->chaincode, 32, I, 37);
 
     if (node->neutered) {
         // Point(IL) + K_par
+        FfxEcCompPubkey child;
+        if (!ffx_ec_tweakAddCompPubkeys(child.data,
+          node->key.pubkey.data, I, 1)) {
+            return false;
+        }
 
-        FfxEcCompPubkey pubkey;
-        if(!ffx_ec_getCompPubkey(&pubkey, &IL)) { return false; }
-
-        ffx_ec_addPointsCompPubkey(node->key.pubkey.data, pubkey.data,
-          node->key.pubkey.data);
+        node->key.pubkey = child;
 
     } else {
         // (IL + k_par) % n
+        FfxEcPrivkey child;
+        if (!ffx_ec_modAddPrivkey(child.data, I, node->key.privkey.data)) {
+            return false;
+        }
 
-        FfxEcPrivkey key;
-        ffx_ec_modAddPrivkey(key.data, IL.data, node->key.privkey.data);
-
-        FfxEcCompPubkey pubkey;
-        if(!ffx_ec_getCompPubkey(&pubkey, &key)) { return false; }
-
-        node->key.privkey = key;
+        node->key.privkey = child;
+        node->hasPubkey = false;
     }
 
     memcpy(node->chaincode, &I[32], 32);
     node->depth++;
     node->index = index;
+    node->parentFingerprint = fingerprint;
 
     return true;
 }
 
-bool ffx_hdnode_derivePath(FfxHDNode *_node, const char* path) {
-    FfxHDNode node = *_node;
-
-    size_t length = strlen(path) + 1;
-    uint32_t index = 0, count = 0;
-    for (int i = 0; i < length; i++) {
-        char c = path[i];
+// Children derived (and neutered children with their points added) at
+// once by ffx_hdnode_deriveChildren
+#define CHILDREN_BATCH_SIZE        (16)
 
-        if (c == '/' || c == '\0') {
-            // Did not contain any actual numbers in the component
-            if (count == 0) { return false; }
+// Derives the %%count%% (non-hardened) children of %%parent%% from
+// %%startIndex%%, given the parent %%pubkey%% and its %%fingerprint%%
+static bool deriveChildren(const FfxHDNode *parent,
+  const FfxEcCompPubkey *pubkey, uint32_t fingerprint, uint32_t startIndex,
+  size_t count, FfxHDNode *childrenOut) {
 
-            ffx_hdnode_deriveChild(&node, index);
+    // Data = ser_p(point(k_par)) || ser_32(i); only the index changes
+    uint8_t data[37];
+    memcpy(data, pubkey->data, 33);
 
-            // Reset
-            count = 0;
-            index = 0;
+    // Every child uses the parent chaincode as the HMAC key
+    FfxHmacSha512Key key;
+    ffx_hmac_initSha512Key(&key, parent->chaincode, 32);
 
-        } else if (c >= '0' && c <= '9') {
-            // Would go out of range
-            if (index > 214748364) { return false; }
+    uint8_t tweaks[CHILDREN_BATCH_SIZE * 32];
+    uint8_t pubkeys[CHILDREN_BATCH_SIZE * 33];
 
-            // Cannot include numbers after a tick
-            if (index & 0x80000000) { return false; }
+    for (size_t base = 0; base < count; base += CHILDREN_BATCH_SIZE) {
+        size_t batchCount = count - base;
+        if (batchCount > CHILDREN_BATCH_SIZE) {
+            batchCount = CHILDREN_BATCH_SIZE;
+        }
 
-            count++;
+        for (size_t i = 0; i < batchCount; i++) {
+            uint32_t index = startIndex + base + i;
+            data[33] = (index >> 24) & 0xff;
+            data[34] = (index >> 16) & 0xff;
+            data[35] = (index >>  8) & 0xff;
+            data[36] = (index >>  0) & 0xff;
+
+            uint8_t I[64];
+            ffx_hmac_sha512WithKey(I, &key, data, sizeof(data));
+
+            FfxHDNode *child = &childrenOut[base + i];
+            memset(child, 0, sizeof(FfxHDNode));
+            child->neutered = parent->neutered;
+            memcpy(child->chaincode, &I[32], 32);
+            child->depth = parent->depth + 1;
+            child->index = index;
+            child->parentFingerprint = fingerprint;
+
+            if (parent->neutered) {
+                // Point(IL) + K_par; added for the whole chunk below
+                memcpy(&tweaks[32 * i], I, 32);
+
+            } else {
+                // (IL + k_par) % n; which fails for an invalid key, so
+                // no point multiplication is needed to validate it
+                if (!ffx_ec_modAddPrivkey(child->key.privkey.data, I,
+                  parent->key.privkey.data)) {
+                    return false;
+                }
+            }
+        }
+
+        if (parent->neutered) {
+            if (!ffx_ec_tweakAddCompPubkeys(pubkeys,
+              parent->key.pubkey.data, tweaks, batchCount)) {
+                return false;
+            }
+
+            for (size_t i = 0; i < batchCount; i++) {
+                memcpy(childrenOut[base + i].key.pubkey.data,
+                  &pubkeys[33 * i], 33);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ffx_hdnode_deriveChildren(const FfxHDNode *_parent, uint32_t startIndex,
+  size_t count, FfxHDNode *childrenOut) {
+
+    // The parent may be one of the children
+    FfxHDNode parent = *_parent;
+
+    if (parent.depth == 0xffffffff) { return false; }
+    if (count == 0) { return true; }
+
+    // Only non-hardened indices
+    if (startIndex & FfxHDNodeHardened) { return false; }
+    if (count - 1 > (FfxHDNodeHardened - 1) - startIndex) { return false; }
+
+    const FfxEcCompPubkey *pubkey = getCompPubkey(&parent);
+    if (pubkey == NULL) { return false; }
+
+    return deriveChildren(&parent, pubkey, getFingerprint(pubkey),
+      startIndex, count, childrenOut);
+}
+
+// The addresses claimed at once by a worker of an address job
+#define ADDRESS_CHUNK_SIZE         (64)
+
+bool ffx_hdnode_initAddressJob(FfxHDNodeAddressJob *job,
+  const FfxHDNode *parent, uint32_t startIndex, size_t count,
+  FfxAddress *addressesOut, FfxChecksumAddress *checksumsOut) {
+
+    memset(job, 0, sizeof(FfxHDNodeAddressJob));
+
+    // Only non-hardened indices
+    if (startIndex & FfxHDNodeHardened) { return false; }
+    if (count && count - 1 > (FfxHDNodeHardened - 1) - startIndex) {
+        return false;
+    }
+
+    if (parent->depth == 0xffffffff) { return false; }
+
+    // Memoize the public key and fingerprint once, rather than in each
+    // batch of each worker
+    job->parent = *parent;
+    const FfxEcCompPubkey *pubkey = getCompPubkey(&job->parent);
+    if (pubkey == NULL) {
+        memset(job, 0, sizeof(FfxHDNodeAddressJob));
+        return false;
+    }
+    job->fingerprint = getFingerprint(pubkey);
+
+    job->startIndex = startIndex;
+    job->count = count;
+    job->addressesOut = addressesOut;
+    job->checksumsOut = checksumsOut;
+
+    return true;
+}
+
+bool ffx_hdnode_runAddressJob(FfxHDNodeAddressJob *job) {
+    FfxHDNode children[CHILDREN_BATCH_SIZE];
+
+    while (!__atomic_load_n(&job->failed, __ATOMIC_RELAXED)) {
+
+        // Claim the next chunk; workers which finish early claim more,
+        // so uneven progress between workers balances
+        size_t chunk = __atomic_fetch_add(&job->nextChunk, 1,
+          __ATOMIC_RELAXED);
+        size_t offset = chunk * ADDRESS_CHUNK_SIZE;
+        if (offset >= job->count) { break; }
+
+        size_t end = offset + ADDRESS_CHUNK_SIZE;
+        if (end > job->count) { end = job->count; }
+
+        for (size_t base = offset; base < end; base += CHILDREN_BATCH_SIZE) {
+            size_t batchCount = end - base;
+            if (batchCount > CHILDREN_BATCH_SIZE) {
+                batchCount = CHILDREN_BATCH_SIZE;
+            }
+
+            bool success = deriveChildren(&job->parent,
+              getCompPubkey(&job->parent), job->fingerprint,
+              job->startIndex + base, batchCount, children);
+
+            for (size_t i = 0; success && i < batchCount; i++) {
+                FfxEcPubkey pubkey;
+                if (!ffx_hdnode_getPubkey(&children[i], false,
+                  pubkey.data)) {
+                    success = false;
+                    break;
+                }
+
+                FfxAddress *address = &job->addressesOut[base + i];
+                *address = ffx_eth_getAddress(&pubkey);
+
+                if (job->checksumsOut) {
+                    job->checksumsOut[base + i] =
+                      ffx_eth_checksumAddress(address);
+                }
+            }
+
+            if (!success) {
+                __atomic_store_n(&job->failed, true, __ATOMIC_RELAXED);
+                return false;
+            }
+        }
+    }
+
+    return !__atomic_load_n(&job->failed, __ATOMIC_RELAXED);
+}
+
+bool ffx_hdnode_getAddresses(const FfxHDNode *parent, uint32_t startIndex,
+  size_t count, FfxAddress *addressesOut, FfxChecksumAddress *checksumsOut) {
+
+    FfxHDNodeAddressJob job;
+    if (!ffx_hdnode_initAddressJob(&job, parent, startIndex, count,
+      addressesOut, checksumsOut)) {
+        return false;
+    }
+
+    return ffx_hdnode_runAddressJob(&job);
+}
+
+// Parses %%path%% into %%indicesOut%% (if non-NULL), returning the number
+// of components or -1 if invalid; a path may only begin with "m" if
+// %%root%%
+static int parsePath(const char* path, bool root, uint32_t *indicesOut) {
+    size_t length = strlen(path) + 1;
+    uint32_t index = 0, digits = 0;
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        char c = path[i];
+
+        if (c == '/' || c == '\0') {
+            // Did not contain any actual numbers in the component
+            if (digits == 0) { return -1; }
+
+            if (indicesOut) { indicesOut[count] = index; }
+            count++;
+
+            // Reset
+            digits = 0;
+            index = 0;
+
+        } else if (c >= '0' && c <= '9') {
+            // Would go out of range
+            if (index > 214748364) { return -1; }
+
+            // Cannot include numbers after a tick
+            if (index & 0x80000000) { return -1; }
+
+            digits++;
             index *= 10;
             index += (c - '0');
 
         } else if (c == '\'') {
             // Cannot include a tick after a tick
-            if (index & 0x80000000) { return false; }
+            if (index & 0x80000000) { return -1; }
 
             index |= 0x80000000;
 
         } else if (c == 'm') {
             // Must be the first component and on a root node
-            if (i != 0 || node.depth != 0) { return false; }
+            if (i != 0 || !root) { return -1; }
 
             // If contains components, m must stand alone
-            if (length > 2 && path[1] != '/') { return false; }
+            if (length > 2 && path[1] != '/') { return -1; }
 
             // m/XXX; skip m/
             i++;
 
         } else {
             // Invalid character
-            return false;
+            return -1;
         }
     }
 
-    *_node = node;
-    return true;
+    return count;
 }
 
-bool ffx_hdnode_deriveAccount(FfxHDNode *_node, uint32_t account) {
-    if (account & FfxHDNodeHardened) { return false; }
+
+// The cache is keyed by the chaincode and key (and neutered state) of
+// the node derivation started from and the indices derived from it
+
+// Returns the key of %%node%% (its private key, or public key if
+// neutered), setting %%lengthOut%%
+static const uint8_t* getNodeKey(const FfxHDNode *node, size_t *lengthOut) {
+    if (node->neutered) {
+        *lengthOut = sizeof(node->key.pubkey.data);
+        return node->key.pubkey.data;
+    }
+
+    *lengthOut = sizeof(node->key.privkey.data);
+    return node->key.privkey.data;
+}
+
+void ffx_hdnode_initCache(FfxHDNodeCache *cache,
+  FfxHDNodeCacheEntry *entries, size_t count) {
+    memset(entries, 0, count * sizeof(FfxHDNodeCacheEntry));
+    cache->entries = entries;
+    cache->count = count;
+    cache->tick = 0;
+}
+
+void ffx_hdnode_clearCache(FfxHDNodeCache *cache) {
+    memset(cache->entries, 0, cache->count * sizeof(FfxHDNodeCacheEntry));
+    cache->tick = 0;
+}
+
+// Returns the entry for the longest prefix (of up to %%count%% indices)
+// of %%indices%% from %%node%%, or NULL
+static FfxHDNodeCacheEntry* findCache(FfxHDNodeCache *cache,
+  const FfxHDNode *node, const uint32_t *indices, size_t count) {
+
+    size_t keyLength;
+    const uint8_t *key = getNodeKey(node, &keyLength);
+
+    FfxHDNodeCacheEntry *best = NULL;
+    for (size_t i = 0; i < cache->count; i++) {
+        FfxHDNodeCacheEntry *entry = &cache->entries[i];
+        if (entry->depth == 0 || entry->depth > count) { continue; }
+        if (best && entry->depth <= best->depth) { continue; }
+
+        if (entry->node.neutered != node->neutered) { continue; }
+        if (memcmp(entry->chaincode, node->chaincode, 32)) { continue; }
+        if (memcmp(entry->key, key, keyLength)) { continue; }
+        if (memcmp(entry->indices, indices,
+          entry->depth * sizeof(uint32_t))) {
+            continue;
+        }
+
+        best = entry;
+    }
+
+    if (best) { best->used = ++cache->tick; }
+
+    return best;
+}
+
+// Adds the %%child%% derived with %%count%% %%indices%% from %%node%%,
+// replacing the least recently used entry
+static void addCache(FfxHDNodeCache *cache, const FfxHDNode *node,
+  const uint32_t *indices, size_t count, const FfxHDNode *child) {
+
+    if (cache->count == 0) { return; }
+
+    FfxHDNodeCacheEntry *entry = &cache->entries[0];
+    for (size_t i = 1; i < cache->count; i++) {
+        if (cache->entries[i].used < entry->used) {
+            entry = &cache->entries[i];
+        }
+    }
+
+    size_t keyLength;
+    const uint8_t *key = getNodeKey(node, &keyLength);
+
+    memset(entry->key, 0, sizeof(entry->key));
+    memcpy(entry->chaincode, node->chaincode, 32);
+    memcpy(entry->key, key, keyLength);
+    memcpy(entry->indices, indices, count * sizeof(uint32_t));
+    entry->depth = count;
+    entry->used = ++cache->tick;
+    entry->node = *child;
+}
+
+// Derives the %%count%% %%indices%% from %%node%%, starting from the
+// deepest cached ancestor (if %%cache%%) and caching each intermediate
+// node derived (i.e. the parents, not the final node)
+static bool deriveIndices(FfxHDNode *_node, const uint32_t *indices,
+  size_t count, FfxHDNodeCache *cache) {
 
     FfxHDNode node = *_node;
 
-    if (!ffx_hdnode_derivePath(&node, "m/44'/60'")) { return false; }
-    if (!ffx_hdnode_deriveChild(&node, FfxHDNodeHardened | account)) {
-        return false;
+    size_t start = 0;
+    if (cache && count > 1) {
+        size_t maxDepth = count - 1;
+        if (maxDepth > FFX_HDNODE_CACHE_MAX_DEPTH) {
+            maxDepth = FFX_HDNODE_CACHE_MAX_DEPTH;
+        }
+
+        FfxHDNodeCacheEntry *entry = findCache(cache, _node, indices,
+          maxDepth);
+        if (entry) {
+            node = entry->node;
+            start = entry->depth;
+        }
+    }
+
+    for (size_t i = start; i < count; i++) {
+        // Cache each parent, with its public key memoized so deriving
+        // further children from the cached node skips it
+        if (cache && i > start && i <= FFX_HDNODE_CACHE_MAX_DEPTH) {
+            if (getCompPubkey(&node) == NULL) { return false; }
+            addCache(cache, _node, indices, i, &node);
+        }
+
+        if (!ffx_hdnode_deriveChild(&node, indices[i])) { return false; }
     }
-    if (!ffx_hdnode_derivePath(&node, "0/0'")) { return false; }
 
     *_node = node;
     return true;
 }
 
-bool ffx_hdnode_deriveIndexedAccount(FfxHDNode *_node, uint32_t account) {
-    if (account & FfxHDNodeHardened) { return false; }
+bool ffx_hdnode_derivePathWithCache(FfxHDNode *node, const char* path,
+  FfxHDNodeCache *cache) {
 
-    FfxHDNode node = *_node;
+    int count = parsePath(path, node->depth == 0, NULL);
+    if (count < 0) { return false; }
+    if (count == 0) { return true; }
 
-    if (!ffx_hdnode_derivePath(&node, "m/44'/60'/0'/0")) { return false; }
-    if (!ffx_hdnode_deriveChild(&node, account)) { return false; }
+    uint32_t indices[count];
+    parsePath(path, node->depth == 0, indices);
+
+    return deriveIndices(node, indices, count, cache);
+}
+
+bool ffx_hdnode_derivePath(FfxHDNode *node, const char* path) {
+    return ffx_hdnode_derivePathWithCache(node, path, NULL);
+}
+
+bool ffx_hdnode_parsePath(FfxHDPath *pathOut, const char* path) {
+    memset(pathOut, 0, sizeof(FfxHDPath));
+
+    int count = parsePath(path, true, NULL);
+    if (count < 0 || count > FFX_HDPATH_MAX_DEPTH) { return false; }
+
+    parsePath(path, true, pathOut->indices);
+    pathOut->depth = count;
+    pathOut->root = (path[0] == 'm');
 
-    *_node = node;
     return true;
 }
 
+bool ffx_hdnode_deriveIndicesWithCache(FfxHDNode *node,
+  const FfxHDPath *path, FfxHDNodeCache *cache) {
+
+    if (path->depth > FFX_HDPATH_MAX_DEPTH) { return false; }
+    if (path->root && node->depth != 0) { return false; }
+
+    return deriveIndices(node, path->indices, path->depth, cache);
+}
+
+bool ffx_hdnode_deriveIndices(FfxHDNode *node, const FfxHDPath *path) {
+    return ffx_hdnode_deriveIndicesWithCache(node, path, NULL);
+}
+
+bool ffx_hdnode_deriveAccountWithCache(FfxHDNode *node, uint32_t account,
+  FfxHDNodeCache *cache) {
+
+    if (account & FfxHDNodeHardened) { return false; }
+
+    const FfxHDPath path = FFX_HDPATH(FfxHDNodeHardened | 44,
+      FfxHDNodeHardened | 60, FfxHDNodeHardened | account, 0,
+      FfxHDNodeHardened | 0);
+
+    return ffx_hdnode_deriveIndicesWithCache(node, &path, cache);
+}
+
+bool ffx_hdnode_deriveAccount(FfxHDNode *node, uint32_t account) {
+    return ffx_hdnode_deriveAccountWithCache(node, account, NULL);
+}
+
+bool ffx_hdnode_deriveIndexedAccountWithCache(FfxHDNode *node,
+  uint32_t account, FfxHDNodeCache *cache) {
+
+    if (account & FfxHDNodeHardened) { return false; }
+
+    const FfxHDPath path = FFX_HDPATH(FfxHDNodeHardened | 44,
+      FfxHDNodeHardened | 60, FfxHDNodeHardened | 0, 0, account);
+
+    return ffx_hdnode_deriveIndicesWithCache(node, &path, cache);
+}
+
+bool ffx_hdnode_deriveIndexedAccount(FfxHDNode *node, uint32_t account) {
+    return ffx_hdnode_deriveIndexedAccountWithCache(node, account, NULL);
+}
+
 bool ffx_hdnode_neuter(FfxHDNode *node) {
     if (node->neutered) { return true; }
 
-    if (!ffx_ec_getCompPubkey(&node->key.pubkey, &node->key.privkey)) {
-        return false;
-    }
+    const FfxEcCompPubkey *pubkey = getCompPubkey(node);
+    if (pubkey == NULL) { return false; }
 
+    // Replaces the private key
+    node->key.pubkey = *pubkey;
     node->neutered = true;
 
     return true;
@@ -414,33 +1278,523 @@ bool ffx_hdnode_getPrivkey(FfxHDNode *node, uint8_t *privkey) {
 
 bool ffx_hdnode_getPubkey(FfxHDNode *node, bool compressed, uint8_t *pubkeyOut) {
     if (compressed) {
-        if (node->neutered) {
-            memcpy(pubkeyOut, node->key.pubkey.data, 33);
-            return true;
-        }
+        const FfxEcCompPubkey *pubkey = getCompPubkey(node);
+        if (pubkey == NULL) { return false; }
+
+        memcpy(pubkeyOut, pubkey->data, 33);
+        return true;
+    }
+
+    FfxEcPubkey pubkey;
 
-        FfxEcCompPubkey pubkey;
-        if (!ffx_ec_getCompPubkey(&pubkey, &node->key.privkey)) {
+    if (node->neutered || node->hasPubkey) {
+        // Decompressing is cheaper than a point multiplication
+        const FfxEcCompPubkey *compPubkey = node->neutered ?
+          &node->key.pubkey: &node->pubkey;
+        if (!ffx_ec_decompressPubkey(&pubkey, compPubkey)) {
             return false;
         }
 
-        memcpy(pubkeyOut, pubkey.data, 33);
-        return true;
+    } else {
+        if (!ffx_ec_getPubkey(&pubkey, &node->key.privkey)) { return false; }
+
+        // Memoize the compressed public key
+        if (ffx_ec_compressPubkey(&node->pubkey, &pubkey)) {
+            node->hasPubkey = true;
+        }
     }
 
-    if (node->neutered) {
+    memcpy(pubkeyOut, pubkey.data, 65);
+    return true;
+}
+
+bool ffx_hdnode_getFingerprint(FfxHDNode *node, uint32_t *fingerprintOut) {
+    const FfxEcCompPubkey *pubkey = getCompPubkey(node);
+    if (pubkey == NULL) { return false; }
+
+    *fingerprintOut = getFingerprint(pubkey);
+    return true;
+}
+
+
+
+///////////////////////////////
+// Extended Keys
+//
+// Base58 is converted in chunks of 5 digits (58^5 < 2^30), so each
+// chunk costs one multiply (or divide) per 32-bit word of the key with
+// a 64-bit intermediate, rather than one per digit per byte.
+
+// The serialized key (78 bytes) followed by its checksum (4 bytes)
+#define EXTKEY_LENGTH              (82)
+#define EXTKEY_CHECKSUM_OFFSET     (78)
+
+// The serialized key as big-endian 32-bit words (zero-padded at the front)
+#define EXTKEY_WORDS               ((EXTKEY_LENGTH + 3) / 4)
+
+#define BASE58_CHUNK_DIGITS        (5)
+#define BASE58_CHUNK_RADIX         (656356768)
+
+static const uint32_t VersionXprv = 0x0488ade4;
+static const uint32_t VersionXpub = 0x0488b21e;
+
+static const char Base58Alphabet[] =
+  "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// The value of each ASCII character, or 0xff if not in the alphabet
+static const uint8_t Base58Values[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06,
+    0x07, 0x08, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+    0x10, 0xff, 0x11, 0x12, 0x13, 0x14, 0x15, 0xff,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d,
+    0x1e, 0x1f, 0x20, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+    0x28, 0x29, 0x2a, 0x2b, 0xff, 0x2c, 0x2d, 0x2e,
+    0x2f, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36,
+    0x37, 0x38, 0x39, 0xff, 0xff, 0xff, 0xff, 0xff,
+};
+
+static uint32_t readBe32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | (data[1] << 16) | (data[2] << 8) |
+      data[3];
+}
+
+static void writeBe32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xff;
+    data[1] = (value >> 16) & 0xff;
+    data[2] = (value >>  8) & 0xff;
+    data[3] = (value >>  0) & 0xff;
+}
+
+// Writes the checksum (the first 4 bytes of the double SHA-256) of the
+// serialized key in %%data%% to %%checksumOut%%
+static void getChecksum(uint8_t *checksumOut, const uint8_t *data) {
+    uint8_t digest[FFX_SHA256_DIGEST_LENGTH];
+    ffx_hash_sha256(digest, data, EXTKEY_CHECKSUM_OFFSET);
+    ffx_hash_sha256(digest, digest, FFX_SHA256_DIGEST_LENGTH);
+    memcpy(checksumOut, digest, 4);
+}
+
+// Encodes the %%length%% bytes (at most EXTKEY_LENGTH) of %%data%% as
+// Base58 into %%textOut%%, which is null-terminated
+static void encodeBase58(char *textOut, const uint8_t *data, size_t length) {
+    size_t wordCount = (length + 3) / 4;
+    size_t padding = 4 * wordCount - length;
+
+    uint32_t words[EXTKEY_WORDS] = { 0 };
+    for (size_t i = 0; i < length; i++) {
+        size_t offset = padding + i;
+        words[offset / 4] |= (uint32_t)data[i] << (8 * (3 - (offset % 4)));
+    }
+
+    // Divide by 58^5 until zero, collecting the digits (least
+    // significant first) of each remainder
+    uint8_t digits[EXTKEY_WORDS * 4 * 2];
+    size_t digitCount = 0;
+
+    size_t first = 0;
+    while (first < wordCount && words[first] == 0) { first++; }
+
+    while (first < wordCount) {
+        uint64_t remainder = 0;
+        for (size_t i = first; i < wordCount; i++) {
+            remainder = (remainder << 32) | words[i];
+            words[i] = remainder / BASE58_CHUNK_RADIX;
+            remainder %= BASE58_CHUNK_RADIX;
+        }
+
+        while (first < wordCount && words[first] == 0) { first++; }
+
+        for (int i = 0; i < BASE58_CHUNK_DIGITS; i++) {
+            digits[digitCount++] = remainder % 58;
+            remainder /= 58;
+        }
+    }
+
+    // The last chunk may have leading zero digits
+    while (digitCount && digits[digitCount - 1] == 0) { digitCount--; }
+
+    // Each leading zero byte is encoded as a leading zero digit
+    size_t offset = 0;
+    for (size_t i = 0; i < length && data[i] == 0; i++) {
+        textOut[offset++] = Base58Alphabet[0];
+    }
+
+    while (digitCount) {
+        textOut[offset++] = Base58Alphabet[digits[--digitCount]];
+    }
+
+    textOut[offset] = 0;
+}
+
+// Decodes the Base58 %%text%% into exactly %%length%% bytes (at most
+// EXTKEY_LENGTH) of %%dataOut%%, returning false if it contains an
+// invalid character or does not encode exactly %%length%% bytes
+static bool decodeBase58(uint8_t *dataOut, size_t length, const char *text) {
+    size_t wordCount = (length + 3) / 4;
+    size_t padding = 4 * wordCount - length;
+
+    // Each byte requires at least one digit and at most 1.37
+    size_t textLength = strlen(text);
+    if (textLength == 0 || textLength > 2 * length) { return false; }
+
+    uint32_t words[EXTKEY_WORDS] = { 0 };
+
+    // The first chunk is short, so the remaining chunks are full
+    size_t chunkLength = textLength % BASE58_CHUNK_DIGITS;
+    if (chunkLength == 0) { chunkLength = BASE58_CHUNK_DIGITS; }
+
+    for (size_t offset = 0; offset < textLength; offset += chunkLength,
+      chunkLength = BASE58_CHUNK_DIGITS) {
+
+        uint32_t value = 0, radix = 1;
+        for (size_t i = 0; i < chunkLength; i++) {
+            uint8_t c = text[offset + i];
+            uint8_t v = (c < sizeof(Base58Values)) ? Base58Values[c]: 0xff;
+            if (v == 0xff) { return false; }
+            value = (value * 58) + v;
+            radix *= 58;
+        }
+
+        // words = (words * radix) + value
+        uint64_t carry = value;
+        for (size_t i = wordCount; i > 0; i--) {
+            carry += (uint64_t)words[i - 1] * radix;
+            words[i - 1] = carry;
+            carry >>= 32;
+        }
+
+        if (carry) { return false; }
+    }
+
+    uint8_t data[EXTKEY_WORDS * 4];
+    for (size_t i = 0; i < wordCount; i++) {
+        writeBe32(&data[4 * i], words[i]);
+    }
+
+    for (size_t i = 0; i < padding; i++) {
+        if (data[i]) { return false; }
+    }
+
+    // The leading zero digits must match the leading zero bytes
+    for (size_t i = 0; i < length; i++) {
+        bool zeroDigit = (i < textLength && text[i] == Base58Alphabet[0]);
+        if (zeroDigit != (data[padding + i] == 0)) { return false; }
+        if (!zeroDigit) { break; }
+    }
+
+    memcpy(dataOut, &data[padding], length);
+
+    return true;
+}
+
+static bool initExtkey(FfxHDNode *node, const char *extkey) {
+    uint8_t data[EXTKEY_LENGTH];
+    if (!decodeBase58(data, sizeof(data), extkey)) { return false; }
+
+    uint8_t checksum[4];
+    getChecksum(checksum, data);
+    if (memcmp(checksum, &data[EXTKEY_CHECKSUM_OFFSET], 4)) { return false; }
+
+    node->depth = data[4];
+    node->parentFingerprint = readBe32(&data[5]);
+    node->index = readBe32(&data[9]);
+    memcpy(node->chaincode, &data[13], 32);
+
+    // The root has no parent
+    if (node->depth == 0 && (node->parentFingerprint || node->index)) {
+        return false;
+    }
+
+    uint32_t version = readBe32(data);
+
+    if (version == VersionXprv) {
+        if (data[45] != 0) { return false; }
+        memcpy(node->key.privkey.data, &data[46], 32);
+
+        // Check the private key is good (memoizing the public key)
+        return (getCompPubkey(node) != NULL);
+
+    } else if (version == VersionXpub) {
+        memcpy(node->key.pubkey.data, &data[45], 33);
+        node->neutered = true;
+
+        // Check the public key is on the curve
         FfxEcPubkey pubkey;
-        if (!ffx_ec_decompressPubkey(&pubkey, &node->key.pubkey)) {
+        return ffx_ec_decompressPubkey(&pubkey, &node->key.pubkey);
+    }
+
+    return false;
+}
+
+bool ffx_hdnode_initExtkey(FfxHDNode *node, const char *extkey) {
+    memset(node, 0, sizeof(FfxHDNode));
+
+    if (!initExtkey(node, extkey)) {
+        memset(node, 0, sizeof(FfxHDNode));
+        return false;
+    }
+
+    return true;
+}
+
+bool ffx_hdnode_getExtendedKey(FfxHDNode *node, char *extkeyOut) {
+    if (node->depth > 0xff) { return false; }
+
+    uint8_t data[EXTKEY_LENGTH] = { 0 };
+
+    writeBe32(data, node->neutered ? VersionXpub: VersionXprv);
+    data[4] = node->depth;
+    writeBe32(&data[5], node->parentFingerprint);
+    writeBe32(&data[9], node->index);
+    memcpy(&data[13], node->chaincode, 32);
+
+    if (node->neutered) {
+        memcpy(&data[45], node->key.pubkey.data, 33);
+    } else {
+        memcpy(&data[46], node->key.privkey.data, 32);
+    }
+
+    getChecksum(&data[EXTKEY_CHECKSUM_OFFSET], data);
+
+    encodeBase58(extkeyOut, data, sizeof(data));
+
+    return true;
+}
+
+
+
+///////////////////////////////
+// Mnemonic Recovery
+//
+// Candidates are numbered in mixed radix over the candidate ranges of
+// the unknown words. Each is checked against the checksum in batches
+// (which are hashed in parallel on hosts with SIMD support), and only
+// checksum-valid candidates have their seed and address derived.
+
+// Candidates checked against the checksum at once
+#define RECOVERY_BATCH_SIZE        (8)
+
+bool ffx_recovery_init(FfxMnemonicRecovery *recovery, const char* phrase,
+  FfxBip39Language language, uint32_t worker, uint32_t workerCount) {
+
+    memset(recovery, 0, sizeof(FfxMnemonicRecovery));
+
+    const Wordlist *wordlist = getWordlist(language);
+    if (wordlist == NULL) { return false; }
+    if (workerCount == 0 || worker >= workerCount) { return false; }
+
+    size_t wordCount = 0;
+
+    size_t offset = 0;
+    while (true) {
+        // Skip whitespace
+        size_t space;
+        while ((space = getSpace(&phrase[offset]))) { offset += space; }
+        if (phrase[offset] == '\0') { break; }
+
+        size_t start = offset;
+        while (phrase[offset] && !getSpace(&phrase[offset])) { offset++; }
+        size_t length = offset - start;
+
+        if (wordCount >= 24) { return false; }
+
+        int index = wordToIndex(wordlist, &phrase[start], length);
+        if (index >= 0) {
+            setWordIndex(recovery->entropy, wordCount++, index);
+            continue;
+        }
+
+        // An unknown word ("?") or an abbreviated word (a prefix)
+        if (recovery->unknownCount == FFX_RECOVERY_MAX_UNKNOWN) {
             return false;
         }
-        memcpy(pubkeyOut, pubkey.data, 65);
-        return true;
+
+        int first = 0;
+        size_t count = 2048;
+        if (length != 1 || phrase[start] != '?') {
+            count = getPrefixRange(wordlist, &phrase[start], length, &first);
+            if (count == 0) { return false; }
+        }
+
+        size_t u = recovery->unknownCount++;
+        recovery->positions[u] = wordCount++;
+        recovery->starts[u] = first;
+        recovery->counts[u] = count;
     }
 
-    FfxEcPubkey pubkey;
-    if (!ffx_ec_getPubkey(&pubkey, &node->key.privkey)) { return false; }
+    if (wordCount < 12 || wordCount % 3) { return false; }
+
+    recovery->language = language;
+    recovery->wordCount = wordCount;
+    recovery->entropyLength = 16 + 4 * ((wordCount - 12) / 3);
+
+    recovery->total = 1;
+    for (int i = 0; i < recovery->unknownCount; i++) {
+        recovery->total *= recovery->counts[i];
+    }
+
+    recovery->next = worker;
+    recovery->stride = workerCount;
+
+    return true;
+}
+
+bool ffx_recovery_setTarget(FfxMnemonicRecovery *recovery,
+  const FfxAddress *target, const char* path, const char* password) {
+
+    if (password && !checkPassword(password)) { return false; }
+
+    // Parsed once, rather than for each candidate
+    if (path) {
+        if (!ffx_hdnode_parsePath(&recovery->path, path)) { return false; }
+    } else {
+        const FfxHDPath defaultPath = FFX_HDPATH_DEFAULT_MNEMONIC;
+        recovery->path = defaultPath;
+    }
+
+    recovery->hasTarget = true;
+    recovery->target = *target;
+    recovery->password = password ? password: "";
 
-    memcpy(pubkeyOut, pubkey.data, 33);
     return true;
 }
 
+bool ffx_recovery_isDone(const FfxMnemonicRecovery *recovery) {
+    return (recovery->next >= recovery->total);
+}
+
+// Writes the entropy (with checksum) of %%candidate%% to %%entropy%%
+static void getCandidate(const FfxMnemonicRecovery *recovery,
+  uint64_t candidate, uint8_t *entropy) {
+
+    const Wordlist *wordlist = getWordlist(recovery->language);
+
+    memcpy(entropy, recovery->entropy, sizeof(recovery->entropy));
+
+    for (int i = 0; i < recovery->unknownCount; i++) {
+        int position = recovery->starts[i] + (candidate % recovery->counts[i]);
+        candidate /= recovery->counts[i];
+
+        setWordIndex(entropy, recovery->positions[i],
+          getSortedIndex(wordlist, position));
+    }
+}
+
+// Returns true if the address for %%seed%% matches the target
+static bool checkTarget(const FfxMnemonicRecovery *recovery,
+  const uint8_t *seed) {
+
+    FfxHDNode node;
+    if (!ffx_hdnode_initSeed(&node, seed)) { return false; }
+    if (!ffx_hdnode_deriveIndices(&node, &recovery->path)) { return false; }
+
+    FfxEcPubkey pubkey;
+    if (!ffx_ec_getPubkey(&pubkey, &node.key.privkey)) { return false; }
+
+    FfxAddress address = ffx_eth_getAddress(&pubkey);
+    return !memcmp(address.data, recovery->target.data,
+      sizeof(address.data));
+}
+
+bool ffx_recovery_step(FfxMnemonicRecovery *recovery, size_t count) {
+    recovery->found = false;
+
+    uint8_t entropies[RECOVERY_BATCH_SIZE][33];
+    const uint8_t *inputs[RECOVERY_BATCH_SIZE];
+    size_t lengths[RECOVERY_BATCH_SIZE];
+    uint64_t candidates[RECOVERY_BATCH_SIZE];
+    uint8_t digests[RECOVERY_BATCH_SIZE * FFX_SHA256_DIGEST_LENGTH];
+
+    size_t entropyLength = recovery->entropyLength;
+    uint8_t mask = getChecksumMask(entropyLength);
+
+    while (count && !ffx_recovery_isDone(recovery)) {
+
+        // Fill a batch of candidates
+        size_t batchCount = 0;
+        uint64_t candidate = recovery->next;
+        while (batchCount < RECOVERY_BATCH_SIZE && batchCount < count &&
+          candidate < recovery->total) {
+
+            getCandidate(recovery, candidate, entropies[batchCount]);
+            inputs[batchCount] = entropies[batchCount];
+            lengths[batchCount] = entropyLength;
+            candidates[batchCount] = candidate;
+            batchCount++;
+
+            candidate += recovery->stride;
+        }
+
+        ffx_hash_sha256Batch(digests, inputs, lengths, batchCount);
+
+        // Collect the checksum-valid candidates (and their batch index)
+        FfxMnemonic mnemonics[RECOVERY_BATCH_SIZE];
+        size_t batchIndices[RECOVERY_BATCH_SIZE];
+        size_t validCount = 0;
+        for (size_t i = 0; i < batchCount; i++) {
+            uint8_t checksum = digests[i * FFX_SHA256_DIGEST_LENGTH] & mask;
+            if ((entropies[i][entropyLength] & mask) != checksum) {
+                continue;
+            }
+
+            FfxMnemonic *mnemonic = &mnemonics[validCount];
+            memset(mnemonic, 0, sizeof(FfxMnemonic));
+            memcpy(mnemonic->entropy, entropies[i], entropyLength + 1);
+            mnemonic->wordCount = recovery->wordCount;
+            mnemonic->entropyLength = entropyLength;
+            mnemonic->language = recovery->language;
+
+            batchIndices[validCount] = i;
+            candidates[validCount++] = candidates[i];
+        }
+
+        // Find the first match; without a target any valid candidate is
+        // a match, otherwise derive the seeds (in parallel) to compare
+        size_t match = validCount;
+        if (!recovery->hasTarget) {
+            if (validCount) { match = 0; }
+
+        } else if (validCount) {
+            uint8_t seeds[RECOVERY_BATCH_SIZE * FFX_BIP39_SEED_LENGTH];
+            if (!ffx_mnemonic_getSeedBatch(mnemonics, validCount,
+              recovery->password, seeds)) {
+                return false;
+            }
+
+            for (size_t i = 0; i < validCount; i++) {
+                if (checkTarget(recovery,
+                  &seeds[i * FFX_BIP39_SEED_LENGTH])) {
+                    match = i;
+                    break;
+                }
+            }
+        }
+
+        if (match < validCount) {
+            recovery->mnemonic = mnemonics[match];
+            recovery->found = true;
+
+            // Continue after the match on the next call; the candidates
+            // after it in this batch are checked again
+            recovery->next = candidates[match] + recovery->stride;
+            recovery->checked += batchIndices[match] + 1;
+            recovery->valid += match + 1;
+            return true;
+        }
+
+        recovery->next = candidate;
+        recovery->checked += batchCount;
+        recovery->valid += validCount;
+        count -= batchCount;
+    }
+
+    return false;
+}
@@ -0,0 +1,180 @@
+#include <string.h>
+
+#include "firefly-bloom.h"
+
+#include "firefly-hash.h"
+
+
+/**
+ *  Each item sets 3 bits, one for each of the first 3 pairs of bytes
+ *  in its hash, taking the bottom 11 bits as a bit index (from the
+ *  end) of the 2048-bit bloom.
+ *
+ *  Testing a single item only reads 3 bytes of a bloom, so testing
+ *  prepared queries is already as cheap as it can be and a SIMD AND
+ *  over the whole filter would only add work. Full-filter operations
+ *  (merging and testing a filter of several items) operate on every
+ *  byte, so use SIMD where available.
+ */
+
+#define TOPIC_LENGTH     (32)
+
+void ffx_bloom_init(FfxBloom *bloom) {
+    memset(bloom->data, 0, sizeof(bloom->data));
+}
+
+void ffx_bloom_initQuery(FfxBloomQuery *query, const uint8_t *data,
+  size_t length) {
+
+    uint8_t hash[32];
+    ffx_hash_keccak256(hash, data, length);
+
+    for (int i = 0; i < 3; i++) {
+        uint16_t bit = ((hash[2 * i] << 8) | hash[2 * i + 1]) & 0x7ff;
+        query->offsets[i] = (FFX_BLOOM_LENGTH - 1) - (bit >> 3);
+        query->masks[i] = 1 << (bit & 0x7);
+    }
+}
+
+void ffx_bloom_addQuery(FfxBloom *bloom, const FfxBloomQuery *query) {
+    for (int i = 0; i < 3; i++) {
+        bloom->data[query->offsets[i]] |= query->masks[i];
+    }
+}
+
+void ffx_bloom_add(FfxBloom *bloom, const uint8_t *data, size_t length) {
+    FfxBloomQuery query;
+    ffx_bloom_initQuery(&query, data, length);
+    ffx_bloom_addQuery(bloom, &query);
+}
+
+void ffx_bloom_addLog(FfxBloom *bloom, const FfxAddress *address,
+  const uint8_t *topics, size_t topicCount) {
+
+    ffx_bloom_add(bloom, address->data, sizeof(address->data));
+
+    for (size_t i = 0; i < topicCount; i++) {
+        ffx_bloom_add(bloom, &topics[i * TOPIC_LENGTH], TOPIC_LENGTH);
+    }
+}
+
+bool ffx_bloom_test(const FfxBloom *bloom, const FfxBloomQuery *query) {
+    const uint8_t *data = bloom->data;
+    return ((data[query->offsets[0]] & query->masks[0]) &&
+      (data[query->offsets[1]] & query->masks[1]) &&
+      (data[query->offsets[2]] & query->masks[2]));
+}
+
+size_t ffx_bloom_testBatch(const FfxBloom *blooms, size_t bloomCount,
+  const FfxBloomQuery *queries, size_t queryCount, uint8_t *matches) {
+
+    size_t count = 0;
+
+    for (size_t b = 0; b < bloomCount; b++) {
+        const uint8_t *data = blooms[b].data;
+
+        for (size_t q = 0; q < queryCount; q++) {
+            const FfxBloomQuery *query = &queries[q];
+
+            // Branchless, as most tests against a sparse bloom fail
+            uint8_t match = (
+              ((data[query->offsets[0]] & query->masks[0]) != 0) &
+              ((data[query->offsets[1]] & query->masks[1]) != 0) &
+              ((data[query->offsets[2]] & query->masks[2]) != 0));
+
+            *matches++ = match;
+            count += match;
+        }
+    }
+
+    return count;
+}
+
+
+/**
+ *  Full-filter operations.
+ *
+ *  On x86-64 hosts, these are compiled for AVX2 and the baseline ISA
+ *  (SSE2), and the loader selects the best one for the running CPU (via
+ *  CPUID). Elsewhere (i.e. on device), they operate on 32-bit words.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+typedef uint64_t BloomWords __attribute__((vector_size(32)));
+
+#define BLOOM_WORDS      (FFX_BLOOM_LENGTH / sizeof(BloomWords))
+
+__attribute__((target_clones("avx2", "default")))
+static void merge(uint8_t *bloom, const uint8_t *other) {
+    for (int i = 0; i < BLOOM_WORDS; i++) {
+        BloomWords a, b;
+        memcpy(&a, &bloom[i * sizeof(BloomWords)], sizeof(BloomWords));
+        memcpy(&b, &other[i * sizeof(BloomWords)], sizeof(BloomWords));
+        a |= b;
+        memcpy(&bloom[i * sizeof(BloomWords)], &a, sizeof(BloomWords));
+    }
+}
+
+__attribute__((target_clones("avx2", "default")))
+static bool includes(const uint8_t *bloom, const uint8_t *filter) {
+    BloomWords missing = { 0 };
+    for (int i = 0; i < BLOOM_WORDS; i++) {
+        BloomWords a, b;
+        memcpy(&a, &bloom[i * sizeof(BloomWords)], sizeof(BloomWords));
+        memcpy(&b, &filter[i * sizeof(BloomWords)], sizeof(BloomWords));
+        missing |= (b & ~a);
+    }
+
+    return ((missing[0] | missing[1] | missing[2] | missing[3]) == 0);
+}
+
+#else
+
+#define BLOOM_WORDS      (FFX_BLOOM_LENGTH / sizeof(uint32_t))
+
+static void merge(uint8_t *bloom, const uint8_t *other) {
+    for (int i = 0; i < BLOOM_WORDS; i++) {
+        uint32_t a, b;
+        memcpy(&a, &bloom[i * sizeof(uint32_t)], sizeof(uint32_t));
+        memcpy(&b, &other[i * sizeof(uint32_t)], sizeof(uint32_t));
+        a |= b;
+        memcpy(&bloom[i * sizeof(uint32_t)], &a, sizeof(uint32_t));
+    }
+}
+
+static bool includes(const uint8_t *bloom, const uint8_t *filter) {
+    uint32_t missing = 0;
+    for (int i = 0; i < BLOOM_WORDS; i++) {
+        uint32_t a, b;
+        memcpy(&a, &bloom[i * sizeof(uint32_t)], sizeof(uint32_t));
+        memcpy(&b, &filter[i * sizeof(uint32_t)], sizeof(uint32_t));
+        missing |= (b & ~a);
+    }
+
+    return (missing == 0);
+}
+
+#endif
+
+void ffx_bloom_merge(FfxBloom *bloom, const FfxBloom *other) {
+    merge(bloom->data, other->data);
+}
+
+bool ffx_bloom_includes(const FfxBloom *bloom, const FfxBloom *filter) {
+    return includes(bloom->data, filter->data);
+}
+
+size_t ffx_bloom_includesBatch(const FfxBloom *blooms, size_t bloomCount,
+  const FfxBloom *filter, uint8_t *matches) {
+
+    size_t count = 0;
+
+    for (size_t b = 0; b < bloomCount; b++) {
+        uint8_t match = includes(blooms[b].data, filter->data);
+        matches[b] = match;
+        count += match;
+    }
+
+    return count;
+}
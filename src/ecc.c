@@ -212,3 +212,28 @@ bool ffx_ec_addPointsCompPubkey(uint8_t *resultOut, const uint8_t *a,
 
     return true;
 }
+
+bool ffx_ec_tweakAddCompPubkeys(uint8_t *resultsOut,
+  const uint8_t *pubkey, const uint8_t *tweaks, size_t count) {
+
+    secp256k1_context *ctx = getContext(NULL);
+
+    // Parse (and decompress) the shared point once
+    secp256k1_pubkey base;
+    int status = secp256k1_ec_pubkey_parse(ctx, &base, pubkey, 33);
+    if (!status) { return false; }
+
+    for (size_t i = 0; i < count; i++) {
+        // Tweaks in place, so each starts from a copy of the shared point
+        secp256k1_pubkey point = base;
+        status = secp256k1_ec_pubkey_tweak_add(ctx, &point, &tweaks[32 * i]);
+        if (!status) { return false; }
+
+        size_t length = 33;
+        status = secp256k1_ec_pubkey_serialize(ctx, &resultsOut[33 * i],
+          &length, &point, SECP256K1_EC_COMPRESSED);
+        if (!status || length != 33) { return false; }
+    }
+
+    return true;
+}
@@ -1,9 +1,9 @@
 /**
  *  Original work by Olivier Gay; see license below.
  *
- *  The only changes are some API name changes to retain library
- *  naming conventions and prevent name collisions. And some unused
- *  functionality is removed.
+ *  The original computed each HMAC from the raw key; it has since been
+ *  reworked around prepared keys (see below), which the PBKDF2
+ *  implementation shares.
  *
  *  See original work at: https://github.com/ogay/hmac
  *
@@ -48,231 +48,215 @@
 #include "firefly-hash.h"
 
 
-#define SHA256_DIGEST_SIZE (FFX_SHA256_DIGEST_LENGTH)
-#define SHA512_DIGEST_SIZE (FFX_SHA512_DIGEST_LENGTH)
-
+/**
+ *  HMAC(K, m) = H((K ^ opad) || H((K ^ ipad) || m))
+ *
+ *  The first block of both the inner and outer hash depends only on the
+ *  key, so a prepared key holds the state after compressing each of
+ *  them (their midstates) and initializing a context for another
+ *  message costs two state copies instead of two compressions.
+ *
+ *  The outer hash always absorbs exactly one digest, which fits in a
+ *  single block with its padding, so it is finalized by transforming a
+ *  prebuilt block from the outer midstate directly.
+ */
 
 #define SHA256_BLOCK_SIZE  (_ffx_sha256_block_length)
 #define SHA512_BLOCK_SIZE  (_ffx_sha512_block_length)
 
-static void sha256_init(FfxSha256Context * ctx) {
-    ffx_hash_initSha256(ctx);
+// See: sha2.c
+void _ffx_hash_xformSha256(FfxSha256Context *ctx, const uint8_t *message);
+void _ffx_hash_xformSha512(FfxSha512Context *ctx, const uint8_t *message);
+
+
+static void writeBe32(uint8_t *data, uint32_t value) {
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value;
 }
-static void sha256_update(FfxSha256Context *ctx, const uint8_t *message,
-                   size_t len) {
-    ffx_hash_updateSha256(ctx, message, len);
+
+static void writeBe64(uint8_t *data, uint64_t value) {
+    writeBe32(data, value >> 32);
+    writeBe32(&data[4], value);
 }
-static void sha256_final(FfxSha256Context *ctx, uint8_t *digest) {
-    ffx_hash_finalSha256(ctx, digest);
+
+// Populates %%block%% with the key XOR %%pad%%, zero-padded to a block
+static void padKey(uint8_t *block, size_t blockLength, const uint8_t *key,
+  size_t length, uint8_t pad) {
+
+    for (int i = 0; i < length; i++) { block[i] = key[i] ^ pad; }
+    memset(&block[length], pad, blockLength - length);
 }
-static void sha256(const uint8_t *message, size_t len,
-            uint8_t *digest) {
-    ffx_hash_sha256(digest, message, len);
+
+// Populates the %%block%% which has the inner digest (of %%length%%
+// bytes) with the padding of the outer message
+static void padDigest(uint8_t *block, size_t blockLength, size_t length) {
+    memset(&block[length], 0, blockLength - length);
+    block[length] = 0x80;
+    writeBe32(&block[blockLength - 4], (blockLength + length) * 8);
 }
 
 
 /* HMAC-SHA-256 functions */
 
-static void hmac_sha256_init(FfxHmacSha256Context *ctx, const uint8_t *key,
-                      size_t key_size)
-{
-    size_t fill;
-    size_t num;
-
-    const uint8_t *key_used;
-    uint8_t key_temp[SHA256_DIGEST_SIZE];
-    int i;
-
-    if (key_size == SHA256_BLOCK_SIZE) {
-        key_used = key;
-        num = SHA256_BLOCK_SIZE;
-    } else {
-        if (key_size > SHA256_BLOCK_SIZE){
-            num = SHA256_DIGEST_SIZE;
-            sha256(key, key_size, key_temp);
-            key_used = key_temp;
-        } else { /* key_size > SHA256_BLOCK_SIZE */
-            key_used = key;
-            num = key_size;
-        }
-        fill = SHA256_BLOCK_SIZE - num;
-
-        memset(ctx->block_ipad + num, 0x36, fill);
-        memset(ctx->block_opad + num, 0x5c, fill);
-    }
+void ffx_hmac_initSha256Key(FfxHmacSha256Key *key, const uint8_t *data,
+  size_t length) {
 
-    for (i = 0; i < (int) num; i++) {
-        ctx->block_ipad[i] = key_used[i] ^ 0x36;
-        ctx->block_opad[i] = key_used[i] ^ 0x5c;
+    // Keys longer than a block are replaced by their hash
+    uint8_t digest[FFX_SHA256_DIGEST_LENGTH];
+    if (length > SHA256_BLOCK_SIZE) {
+        ffx_hash_sha256(digest, data, length);
+        data = digest;
+        length = sizeof(digest);
     }
 
-    sha256_init(&ctx->ctx_inside);
-    sha256_update(&ctx->ctx_inside, ctx->block_ipad, SHA256_BLOCK_SIZE);
-
-    sha256_init(&ctx->ctx_outside);
-    sha256_update(&ctx->ctx_outside, ctx->block_opad,
-                  SHA256_BLOCK_SIZE);
-}
+    uint8_t block[SHA256_BLOCK_SIZE];
+    FfxSha256Context ctx;
 
+    padKey(block, SHA256_BLOCK_SIZE, data, length, 0x36);
+    ffx_hash_initSha256(&ctx);
+    _ffx_hash_xformSha256(&ctx, block);
+    memcpy(key->inner, ctx.h, sizeof(key->inner));
 
-static void hmac_sha256_update(FfxHmacSha256Context *ctx, const uint8_t *message,
-                        size_t message_len)
-{
-    sha256_update(&ctx->ctx_inside, message, message_len);
+    padKey(block, SHA256_BLOCK_SIZE, data, length, 0x5c);
+    ffx_hash_initSha256(&ctx);
+    _ffx_hash_xformSha256(&ctx, block);
+    memcpy(key->outer, ctx.h, sizeof(key->outer));
 }
 
-static void hmac_sha256_final(FfxHmacSha256Context *ctx, uint8_t *mac,
-                       size_t mac_size)
-{
-    uint8_t digest_inside[SHA256_DIGEST_SIZE];
-    uint8_t mac_temp[SHA256_DIGEST_SIZE];
-
-    sha256_final(&ctx->ctx_inside, digest_inside);
-    sha256_update(&ctx->ctx_outside, digest_inside, SHA256_DIGEST_SIZE);
-    sha256_final(&ctx->ctx_outside, mac_temp);
-    memcpy(mac, mac_temp, mac_size);
-}
+void ffx_hmac_initSha256WithKey(FfxHmacSha256Context *context,
+  const FfxHmacSha256Key *key) {
 
-static void hmac_sha256(const uint8_t *key, size_t key_size,
-          const uint8_t *message, size_t message_len,
-          uint8_t *mac, unsigned mac_size)
-{
-    FfxHmacSha256Context ctx;
+    memcpy(context->inner.h, key->inner, sizeof(key->inner));
+    context->inner.len = 0;
+    context->inner.tot_len = SHA256_BLOCK_SIZE;
 
-    hmac_sha256_init(&ctx, key, key_size);
-    hmac_sha256_update(&ctx, message, message_len);
-    hmac_sha256_final(&ctx, mac, mac_size);
+    memcpy(context->outer, key->outer, sizeof(key->outer));
 }
 
 void ffx_hmac_initSha256(FfxHmacSha256Context *context,
   const uint8_t *key, size_t length) {
 
-    hmac_sha256_init(context, key, length);
+    FfxHmacSha256Key prepared;
+    ffx_hmac_initSha256Key(&prepared, key, length);
+    ffx_hmac_initSha256WithKey(context, &prepared);
 }
 
 void ffx_hmac_updateSha256(FfxHmacSha256Context *context,
   const uint8_t *data, size_t length) {
-    hmac_sha256_update(context, data, length);
+    ffx_hash_updateSha256(&context->inner, data, length);
 }
 
 void ffx_hmac_finalSha256(FfxHmacSha256Context *context, uint8_t *hmac) {
-    hmac_sha256_final(context, hmac, SHA256_DIGEST_SIZE);
-}
+    FfxSha256Context *ctx = &context->inner;
 
-void ffx_hmac_sha256(uint8_t *digest, const uint8_t *key, size_t keyLen,
-  const uint8_t *data, size_t dataLen) {
-    hmac_sha256(key, keyLen, data, dataLen, digest, SHA256_DIGEST_SIZE);
-}
+    uint8_t block[SHA256_BLOCK_SIZE];
+    ffx_hash_finalSha256(ctx, block);
+    padDigest(block, SHA256_BLOCK_SIZE, FFX_SHA256_DIGEST_LENGTH);
 
+    memcpy(ctx->h, context->outer, sizeof(context->outer));
+    _ffx_hash_xformSha256(ctx, block);
 
+    for (int i = 0; i < 8; i++) { writeBe32(&hmac[i * 4], ctx->h[i]); }
+}
 
-/* HMAC-SHA-512 functions */
+void ffx_hmac_sha256WithKey(uint8_t *digest, const FfxHmacSha256Key *key,
+  const uint8_t *data, size_t length) {
 
-static void sha512_init(FfxSha512Context *ctx) {
-    ffx_hash_initSha512(ctx);
+    FfxHmacSha256Context ctx;
+    ffx_hmac_initSha256WithKey(&ctx, key);
+    ffx_hmac_updateSha256(&ctx, data, length);
+    ffx_hmac_finalSha256(&ctx, digest);
 }
 
-static void sha512_update(FfxSha512Context *ctx, const uint8_t *message,
-                   size_t len) {
-    ffx_hash_updateSha512(ctx, message, len);
-}
-static void sha512_final(FfxSha512Context *ctx, uint8_t *digest) {
-    ffx_hash_finalSha512(ctx, digest);
+void ffx_hmac_sha256(uint8_t *digest, const uint8_t *key, size_t keyLen,
+  const uint8_t *data, size_t dataLen) {
+
+    FfxHmacSha256Context ctx;
+    ffx_hmac_initSha256(&ctx, key, keyLen);
+    ffx_hmac_updateSha256(&ctx, data, dataLen);
+    ffx_hmac_finalSha256(&ctx, digest);
 }
 
-static void sha512(const uint8_t *message, size_t len,
-            uint8_t *digest) {
-    ffx_hash_sha512(digest, message, len);
 
-}
+/* HMAC-SHA-512 functions */
 
-static void hmac_sha512_init(FfxHmacSha512Context *ctx, const uint8_t *key,
-                      size_t key_size)
-{
-    size_t fill;
-    size_t num;
-
-    const uint8_t *key_used;
-    uint8_t key_temp[SHA512_DIGEST_SIZE];
-    int i;
-
-    if (key_size == SHA512_BLOCK_SIZE) {
-        key_used = key;
-        num = SHA512_BLOCK_SIZE;
-    } else {
-        if (key_size > SHA512_BLOCK_SIZE){
-            num = SHA512_DIGEST_SIZE;
-            sha512(key, key_size, key_temp);
-            key_used = key_temp;
-        } else { /* key_size > SHA512_BLOCK_SIZE */
-            key_used = key;
-            num = key_size;
-        }
-        fill = SHA512_BLOCK_SIZE - num;
-
-        memset(ctx->block_ipad + num, 0x36, fill);
-        memset(ctx->block_opad + num, 0x5c, fill);
-    }
+void ffx_hmac_initSha512Key(FfxHmacSha512Key *key, const uint8_t *data,
+  size_t length) {
 
-    for (i = 0; i < (int) num; i++) {
-        ctx->block_ipad[i] = key_used[i] ^ 0x36;
-        ctx->block_opad[i] = key_used[i] ^ 0x5c;
+    // Keys longer than a block are replaced by their hash
+    uint8_t digest[FFX_SHA512_DIGEST_LENGTH];
+    if (length > SHA512_BLOCK_SIZE) {
+        ffx_hash_sha512(digest, data, length);
+        data = digest;
+        length = sizeof(digest);
     }
 
-    sha512_init(&ctx->ctx_inside);
-    sha512_update(&ctx->ctx_inside, ctx->block_ipad, SHA512_BLOCK_SIZE);
+    uint8_t block[SHA512_BLOCK_SIZE];
+    FfxSha512Context ctx;
 
-    sha512_init(&ctx->ctx_outside);
-    sha512_update(&ctx->ctx_outside, ctx->block_opad,
-                  SHA512_BLOCK_SIZE);
-}
+    padKey(block, SHA512_BLOCK_SIZE, data, length, 0x36);
+    ffx_hash_initSha512(&ctx);
+    _ffx_hash_xformSha512(&ctx, block);
+    memcpy(key->inner, ctx.h, sizeof(key->inner));
 
-static void hmac_sha512_update(FfxHmacSha512Context *ctx, const uint8_t *message,
-                        size_t message_len)
-{
-    sha512_update(&ctx->ctx_inside, message, message_len);
+    padKey(block, SHA512_BLOCK_SIZE, data, length, 0x5c);
+    ffx_hash_initSha512(&ctx);
+    _ffx_hash_xformSha512(&ctx, block);
+    memcpy(key->outer, ctx.h, sizeof(key->outer));
 }
 
-static void hmac_sha512_final(FfxHmacSha512Context *ctx, uint8_t *mac,
-                       size_t mac_size)
-{
-    uint8_t digest_inside[SHA512_DIGEST_SIZE];
-    uint8_t mac_temp[SHA512_DIGEST_SIZE];
+void ffx_hmac_initSha512WithKey(FfxHmacSha512Context *context,
+  const FfxHmacSha512Key *key) {
 
-    sha512_final(&ctx->ctx_inside, digest_inside);
-    sha512_update(&ctx->ctx_outside, digest_inside, SHA512_DIGEST_SIZE);
-    sha512_final(&ctx->ctx_outside, mac_temp);
-    memcpy(mac, mac_temp, mac_size);
-}
+    memcpy(context->inner.h, key->inner, sizeof(key->inner));
+    context->inner.len = 0;
+    context->inner.tot_len = SHA512_BLOCK_SIZE;
 
-static void hmac_sha512(const uint8_t *key, size_t key_size,
-          const uint8_t *message, size_t message_len,
-          uint8_t *mac, unsigned mac_size)
-{
-    FfxHmacSha512Context ctx;
-
-    hmac_sha512_init(&ctx, key, key_size);
-    hmac_sha512_update(&ctx, message, message_len);
-    hmac_sha512_final(&ctx, mac, mac_size);
+    memcpy(context->outer, key->outer, sizeof(key->outer));
 }
 
 void ffx_hmac_initSha512(FfxHmacSha512Context *context,
   const uint8_t *key, size_t length) {
 
-    hmac_sha512_init(context, key, length);
+    FfxHmacSha512Key prepared;
+    ffx_hmac_initSha512Key(&prepared, key, length);
+    ffx_hmac_initSha512WithKey(context, &prepared);
 }
 
 void ffx_hmac_updateSha512(FfxHmacSha512Context *context,
   const uint8_t *data, size_t length) {
-    hmac_sha512_update(context, data, length);
+    ffx_hash_updateSha512(&context->inner, data, length);
 }
 
 void ffx_hmac_finalSha512(FfxHmacSha512Context *context, uint8_t *hmac) {
-    hmac_sha512_final(context, hmac, SHA512_DIGEST_SIZE);
+    FfxSha512Context *ctx = &context->inner;
+
+    uint8_t block[SHA512_BLOCK_SIZE];
+    ffx_hash_finalSha512(ctx, block);
+    padDigest(block, SHA512_BLOCK_SIZE, FFX_SHA512_DIGEST_LENGTH);
+
+    memcpy(ctx->h, context->outer, sizeof(context->outer));
+    _ffx_hash_xformSha512(ctx, block);
+
+    for (int i = 0; i < 8; i++) { writeBe64(&hmac[i * 8], ctx->h[i]); }
+}
+
+void ffx_hmac_sha512WithKey(uint8_t *digest, const FfxHmacSha512Key *key,
+  const uint8_t *data, size_t length) {
+
+    FfxHmacSha512Context ctx;
+    ffx_hmac_initSha512WithKey(&ctx, key);
+    ffx_hmac_updateSha512(&ctx, data, length);
+    ffx_hmac_finalSha512(&ctx, digest);
 }
 
 void ffx_hmac_sha512(uint8_t *digest, const uint8_t *key, size_t keyLen,
   const uint8_t *data, size_t dataLen) {
 
-    hmac_sha512(key, keyLen, data, dataLen, digest, SHA512_DIGEST_SIZE);
+    FfxHmacSha512Context ctx;
+    ffx_hmac_initSha512(&ctx, key, keyLen);
+    ffx_hmac_updateSha512(&ctx, data, dataLen);
+    ffx_hmac_finalSha512(&ctx, digest);
 }
@@ -33,9 +33,200 @@
 #define I64(x) x##LL
 #define ROTL64(qword, n) ((qword) << (n) ^ ((qword) >> (64 - (n))))
 #define le2me_64(x) (x)
-#define IS_ALIGNED_64(p) (0 == (7 & ((const char*)(p) - (const char*)0)))
 #define me64_to_le_str(to, from, length) memcpy((to), (from), (length))
 
+/**
+ *  The permutation is available in two variants, selected at build time:
+ *    - compact (default); small tables and loops, to keep flash usage low
+ *      on device
+ *    - unrolled (FFX_KECCAK_UNROLLED); several times faster, at the
+ *      cost of several KB of additional code
+ */
+
+/* Initializing a sha3 context for given number of output bits */
+void ffx_hash_initKeccak256(FfxKeccak256Context *context) {
+    memset(context, 0, sizeof(FfxKeccak256Context));
+}
+
+/**
+ *  Fully unrolled permutation (FFX_KECCAK_UNROLLED).
+ *
+ *  This trades flash for speed; every round is expanded inline with its
+ *  round constant and rho offsets as literals, and the state is held in
+ *  25 local lanes so the compiler can keep as much of it as possible in
+ *  registers.
+ *
+ *  The lane-complementing transform is used to reduce the number of NOT
+ *  operations in chi from 5 per row to 1. The lanes in
+ *  KECCAK_COMPLEMENT_LANES are stored inverted during the rounds and
+ *  restored before returning, so the in-memory state is unaffected.
+ *
+ *  The lane type is a parameter, so the same rounds are also used for
+ *  the multi-buffer permutation below.
+ *
+ *  See: The Keccak implementation overview, Section 2.2
+ */
+
+// Lanes are named by row (b, g, k, m, s) and column (a, e, i, o, u)
+#define KECCAK_LANES(T, P) \
+    T P##ba, P##be, P##bi, P##bo, P##bu, \
+             P##ga, P##ge, P##gi, P##go, P##gu, \
+             P##ka, P##ke, P##ki, P##ko, P##ku, \
+             P##ma, P##me, P##mi, P##mo, P##mu, \
+             P##sa, P##se, P##si, P##so, P##su;
+
+#define KECCAK_COMPLEMENT_LANES(S) \
+    { \
+        (S)[1] = ~(S)[1]; (S)[2] = ~(S)[2]; (S)[8] = ~(S)[8]; \
+        (S)[12] = ~(S)[12]; (S)[17] = ~(S)[17]; (S)[20] = ~(S)[20]; \
+    }
+
+// One round (theta, rho, pi, chi with lane complementing, iota) reading
+// the lanes prefixed A and writing the lanes prefixed E
+#define KECCAK_ROUND(T, A, E, RC) \
+    { \
+        T Ca, Ce, Ci, Co, Cu, Da, De, Di, Do, Du; \
+        T Ba, Be, Bi, Bo, Bu; \
+        \
+        Ca = A##ba ^ A##ga ^ A##ka ^ A##ma ^ A##sa; \
+        Ce = A##be ^ A##ge ^ A##ke ^ A##me ^ A##se; \
+        Ci = A##bi ^ A##gi ^ A##ki ^ A##mi ^ A##si; \
+        Co = A##bo ^ A##go ^ A##ko ^ A##mo ^ A##so; \
+        Cu = A##bu ^ A##gu ^ A##ku ^ A##mu ^ A##su; \
+        \
+        Da = Cu ^ ROTL64(Ce, 1); \
+        De = Ca ^ ROTL64(Ci, 1); \
+        Di = Ce ^ ROTL64(Co, 1); \
+        Do = Ci ^ ROTL64(Cu, 1); \
+        Du = Co ^ ROTL64(Ca, 1); \
+        \
+        Ba = A##ba ^ Da; \
+        Be = ROTL64(A##ge ^ De, 44); \
+        Bi = ROTL64(A##ki ^ Di, 43); \
+        Bo = ROTL64(A##mo ^ Do, 21); \
+        Bu = ROTL64(A##su ^ Du, 14); \
+        E##ba = Ba ^ (Be | Bi) ^ (RC); \
+        E##be = Be ^ (~Bi | Bo); \
+        E##bi = Bi ^ (Bo & Bu); \
+        E##bo = Bo ^ (Bu | Ba); \
+        E##bu = Bu ^ (Ba & Be); \
+        \
+        Ba = ROTL64(A##bo ^ Do, 28); \
+        Be = ROTL64(A##gu ^ Du, 20); \
+        Bi = ROTL64(A##ka ^ Da, 3); \
+        Bo = ROTL64(A##me ^ De, 45); \
+        Bu = ROTL64(A##si ^ Di, 61); \
+        E##ga = Ba ^ (Be | Bi); \
+        E##ge = Be ^ (Bi & Bo); \
+        E##gi = Bi ^ (Bo | ~Bu); \
+        E##go = Bo ^ (Bu | Ba); \
+        E##gu = Bu ^ (Ba & Be); \
+        \
+        Ba = ROTL64(A##be ^ De, 1); \
+        Be = ROTL64(A##gi ^ Di, 6); \
+        Bi = ROTL64(A##ko ^ Do, 25); \
+        Bo = ROTL64(A##mu ^ Du, 8); \
+        Bu = ROTL64(A##sa ^ Da, 18); \
+        E##ka = Ba ^ (Be | Bi); \
+        E##ke = Be ^ (Bi & Bo); \
+        E##ki = Bi ^ (~Bo & Bu); \
+        E##ko = ~Bo ^ (Bu | Ba); \
+        E##ku = Bu ^ (Ba & Be); \
+        \
+        Ba = ROTL64(A##bu ^ Du, 27); \
+        Be = ROTL64(A##ga ^ Da, 36); \
+        Bi = ROTL64(A##ke ^ De, 10); \
+        Bo = ROTL64(A##mi ^ Di, 15); \
+        Bu = ROTL64(A##so ^ Do, 56); \
+        E##ma = Ba ^ (Be & Bi); \
+        E##me = Be ^ (Bi | Bo); \
+        E##mi = Bi ^ (~Bo | Bu); \
+        E##mo = ~Bo ^ (Bu & Ba); \
+        E##mu = Bu ^ (Ba | Be); \
+        \
+        Ba = ROTL64(A##bi ^ Di, 62); \
+        Be = ROTL64(A##go ^ Do, 55); \
+        Bi = ROTL64(A##ku ^ Du, 39); \
+        Bo = ROTL64(A##ma ^ Da, 41); \
+        Bu = ROTL64(A##se ^ De, 2); \
+        E##sa = Ba ^ (~Be & Bi); \
+        E##se = ~Be ^ (Bi | Bo); \
+        E##si = Bi ^ (Bo & Bu); \
+        E##so = Bo ^ (Bu | Ba); \
+        E##su = Bu ^ (Ba & Be); \
+    }
+
+#define KECCAK_LOAD(P, S) \
+    { \
+        P##ba = (S)[ 0]; P##be = (S)[ 1]; P##bi = (S)[ 2]; \
+        P##bo = (S)[ 3]; P##bu = (S)[ 4]; P##ga = (S)[ 5]; \
+        P##ge = (S)[ 6]; P##gi = (S)[ 7]; P##go = (S)[ 8]; \
+        P##gu = (S)[ 9]; P##ka = (S)[10]; P##ke = (S)[11]; \
+        P##ki = (S)[12]; P##ko = (S)[13]; P##ku = (S)[14]; \
+        P##ma = (S)[15]; P##me = (S)[16]; P##mi = (S)[17]; \
+        P##mo = (S)[18]; P##mu = (S)[19]; P##sa = (S)[20]; \
+        P##se = (S)[21]; P##si = (S)[22]; P##so = (S)[23]; \
+        P##su = (S)[24]; \
+    }
+
+#define KECCAK_STORE(S, P) \
+    { \
+        (S)[ 0] = P##ba; (S)[ 1] = P##be; (S)[ 2] = P##bi; \
+        (S)[ 3] = P##bo; (S)[ 4] = P##bu; (S)[ 5] = P##ga; \
+        (S)[ 6] = P##ge; (S)[ 7] = P##gi; (S)[ 8] = P##go; \
+        (S)[ 9] = P##gu; (S)[10] = P##ka; (S)[11] = P##ke; \
+        (S)[12] = P##ki; (S)[13] = P##ko; (S)[14] = P##ku; \
+        (S)[15] = P##ma; (S)[16] = P##me; (S)[17] = P##mi; \
+        (S)[18] = P##mo; (S)[19] = P##mu; (S)[20] = P##sa; \
+        (S)[21] = P##se; (S)[22] = P##si; (S)[23] = P##so; \
+        (S)[24] = P##su; \
+    }
+
+#define KECCAK_PERMUTE(T, S) \
+    { \
+        KECCAK_LANES(T, A) \
+        KECCAK_LANES(T, E) \
+        \
+        KECCAK_COMPLEMENT_LANES(S); \
+        KECCAK_LOAD(A, S); \
+        \
+        KECCAK_ROUND(T, A, E, I64(0x0000000000000001)); \
+        KECCAK_ROUND(T, E, A, I64(0x0000000000008082)); \
+        KECCAK_ROUND(T, A, E, I64(0x800000000000808a)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000080008000)); \
+        KECCAK_ROUND(T, A, E, I64(0x000000000000808b)); \
+        KECCAK_ROUND(T, E, A, I64(0x0000000080000001)); \
+        KECCAK_ROUND(T, A, E, I64(0x8000000080008081)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000000008009)); \
+        KECCAK_ROUND(T, A, E, I64(0x000000000000008a)); \
+        KECCAK_ROUND(T, E, A, I64(0x0000000000000088)); \
+        KECCAK_ROUND(T, A, E, I64(0x0000000080008009)); \
+        KECCAK_ROUND(T, E, A, I64(0x000000008000000a)); \
+        KECCAK_ROUND(T, A, E, I64(0x000000008000808b)); \
+        KECCAK_ROUND(T, E, A, I64(0x800000000000008b)); \
+        KECCAK_ROUND(T, A, E, I64(0x8000000000008089)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000000008003)); \
+        KECCAK_ROUND(T, A, E, I64(0x8000000000008002)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000000000080)); \
+        KECCAK_ROUND(T, A, E, I64(0x000000000000800a)); \
+        KECCAK_ROUND(T, E, A, I64(0x800000008000000a)); \
+        KECCAK_ROUND(T, A, E, I64(0x8000000080008081)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000000008080)); \
+        KECCAK_ROUND(T, A, E, I64(0x0000000080000001)); \
+        KECCAK_ROUND(T, E, A, I64(0x8000000080008008)); \
+        \
+        KECCAK_STORE(S, A); \
+        KECCAK_COMPLEMENT_LANES(S); \
+    }
+
+#ifdef FFX_KECCAK_UNROLLED
+
+static void sha3_permutation(uint64_t *state) {
+    KECCAK_PERMUTE(uint64_t, state);
+}
+
+#else  /* FFX_KECCAK_UNROLLED */
+
 /* constants */
 
 const uint8_t constants[]  = {
@@ -70,11 +261,6 @@ static uint64_t get_round_constant(uint8_t round) {
 }
 
 
-/* Initializing a sha3 context for given number of output bits */
-void ffx_hash_initKeccak256(FfxKeccak256Context *context) {
-    memset(context, 0, sizeof(FfxKeccak256Context));
-}
-
 /* Keccak theta() transformation */
 static void keccak_theta(uint64_t *A) {
     uint64_t C[5], D[5];
@@ -134,6 +320,8 @@ static void sha3_permutation(uint64_t *state) {
     }
 }
 
+#endif  /* FFX_KECCAK_UNROLLED */
+
 /**
  * The core transformation. Process the specified block of data.
  *
@@ -150,6 +338,21 @@ static void sha3_process_block(uint64_t hash[25], const uint64_t *block) {
     sha3_permutation(hash);
 }
 
+/**
+ *  Process a block of data directly from the input, which may be
+ *  unaligned, without first copying it into the message buffer.
+ */
+static void sha3_process_bytes(uint64_t hash[25], const uint8_t *block) {
+    for (uint8_t i = 0; i < 17; i++) {
+        uint64_t word;
+        memcpy(&word, &block[i * 8], 8);
+        hash[i] ^= le2me_64(word);
+    }
+
+    /* make a permutation of the hash */
+    sha3_permutation(hash);
+}
+
 //#define SHA3_FINALIZED 0x80000000
 //#define SHA3_FINALIZED 0x8000
 
@@ -181,16 +384,7 @@ void ffx_hash_updateKeccak256(FfxKeccak256Context *context,
     }
 
     while (dataLength >= KECCAK256_BLOCK_SIZE) {
-        uint64_t* aligned_message_block;
-        if (IS_ALIGNED_64(data)) {
-            // the most common case is processing of an already aligned message without copying it
-            aligned_message_block = (uint64_t*)(void*)data;
-        } else {
-            memcpy(context->message, data, KECCAK256_BLOCK_SIZE);
-            aligned_message_block = context->message;
-        }
-
-        sha3_process_block(context->hash, aligned_message_block);
+        sha3_process_bytes(context->hash, data);
         data  += KECCAK256_BLOCK_SIZE;
         dataLength -= KECCAK256_BLOCK_SIZE;
     }
@@ -200,6 +394,14 @@ void ffx_hash_updateKeccak256(FfxKeccak256Context *context,
     }
 }
 
+void ffx_hash_updateSegmentsKeccak256(FfxKeccak256Context *context,
+  const FfxHashSegment *segments, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        ffx_hash_updateKeccak256(context, segments[i].data,
+          segments[i].length);
+    }
+}
+
 /**
 * Store calculated hash into the given array.
 *
@@ -231,3 +433,184 @@ void ffx_hash_keccak256(uint8_t *digest, const uint8_t *data, size_t length) {
     ffx_hash_updateKeccak256(&ctx, data, length);
     ffx_hash_finalKeccak256(&ctx, digest);
 }
+
+// Hash a message of %%words%% 64-bit words, which must be less than the
+// block size, skipping the buffering in the update and final path
+static inline void keccak256Words(uint8_t *digest, const uint8_t *data,
+  size_t words) {
+
+    uint64_t state[_ffx_sha3_max_permutation_size] = { 0 };
+
+    memcpy(state, data, words * 8);
+    for (uint8_t i = 0; i < words; i++) { state[i] = le2me_64(state[i]); }
+
+    // Padding; 0x01 after the message and 0x80 at the end of the block
+    state[words] = 0x01;
+    state[KECCAK256_BLOCK_SIZE / 8 - 1] |= I64(0x8000000000000000);
+
+    sha3_permutation(state);
+
+    me64_to_le_str(digest, state, FFX_KECCAK256_DIGEST_LENGTH);
+}
+
+void ffx_hash_keccak256_32(uint8_t *digest, const uint8_t *data) {
+    keccak256Words(digest, data, 4);
+}
+
+void ffx_hash_keccak256_40(uint8_t *digest, const uint8_t *data) {
+    keccak256Words(digest, data, 5);
+}
+
+void ffx_hash_keccak256_64(uint8_t *digest, const uint8_t *data) {
+    keccak256Words(digest, data, 8);
+}
+
+void ffx_hash_cloneKeccak256(FfxKeccak256Context *context,
+  const FfxKeccak256Context *source) {
+
+    memcpy(context->hash, source->hash, sizeof(context->hash));
+
+    // Bytes past rest are never read before being overwritten
+    memcpy(context->message, source->message, source->rest);
+    context->rest = source->rest;
+}
+
+void ffx_hash_initKeccak256Prefix(FfxKeccak256Prefix *prefix,
+  const uint8_t *data, size_t length) {
+
+    ffx_hash_initKeccak256(&prefix->context);
+    ffx_hash_updateKeccak256(&prefix->context, data, length);
+}
+
+void ffx_hash_initKeccak256WithPrefix(FfxKeccak256Context *context,
+  const FfxKeccak256Prefix *prefix) {
+    ffx_hash_cloneKeccak256(context, &prefix->context);
+}
+
+void ffx_hash_keccak256WithPrefix(uint8_t *digest,
+  const FfxKeccak256Prefix *prefix, const uint8_t *data, size_t length) {
+
+    FfxKeccak256Context ctx;
+    ffx_hash_cloneKeccak256(&ctx, &prefix->context);
+    ffx_hash_updateKeccak256(&ctx, data, length);
+    ffx_hash_finalKeccak256(&ctx, digest);
+}
+
+
+/**
+ *  Multi-buffer hashing.
+ *
+ *  On x86-64 hosts, independent messages are hashed in groups of
+ *  KECCAK_BATCH_LANES, with each of the 25 state words stored as a
+ *  vector of lanes so one word of every state fits in a SIMD register.
+ *  The permutation is compiled for AVX-512, AVX2 and the baseline ISA,
+ *  and the loader selects the best one for the running CPU (via CPUID).
+ *
+ *  Lanes in a group advance in lock-step, so messages of similar length
+ *  should be batched together; a short message in a group with a long
+ *  one is carried along (wasting its lane) until the longest finishes.
+ *
+ *  Elsewhere (i.e. on device), each message is simply hashed in turn.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+#define KECCAK_BATCH_LANES     (8)
+
+// Each word holds that word of every state in the group; GCC and Clang
+// lower the operations to the widest vector registers available
+typedef uint64_t BatchLane __attribute__((vector_size(8 * KECCAK_BATCH_LANES)));
+
+typedef BatchLane BatchState[25];
+
+__attribute__((target_clones("avx512f", "avx2", "default")))
+static void sha3_permutationBatch(BatchState state) {
+    KECCAK_PERMUTE(BatchLane, state);
+}
+
+// Absorbs the block %%index%% of %%data%% into %%lane%%, applying the
+// padding if this is the final block of the message
+static void sha3_absorbBatch(BatchState state, int lane, const uint8_t *data,
+  size_t length, size_t index) {
+
+    uint64_t block[KECCAK256_BLOCK_SIZE / 8];
+
+    size_t offset = index * KECCAK256_BLOCK_SIZE;
+    size_t remaining = length - offset;
+
+    if (remaining >= KECCAK256_BLOCK_SIZE) {
+        memcpy(block, &data[offset], KECCAK256_BLOCK_SIZE);
+    } else {
+        memset(block, 0, KECCAK256_BLOCK_SIZE);
+        memcpy(block, &data[offset], remaining);
+        ((uint8_t*)block)[remaining] |= 0x01;
+        ((uint8_t*)block)[KECCAK256_BLOCK_SIZE - 1] |= 0x80;
+    }
+
+    for (uint8_t i = 0; i < KECCAK256_BLOCK_SIZE / 8; i++) {
+        state[i][lane] ^= le2me_64(block[i]);
+    }
+}
+
+void ffx_hash_keccak256Batch(uint8_t *digests, const uint8_t * const *inputs,
+  const size_t *lengths, size_t count) {
+
+    BatchState state;
+
+    for (size_t base = 0; base < count; base += KECCAK_BATCH_LANES) {
+        size_t lanes = count - base;
+        if (lanes > KECCAK_BATCH_LANES) { lanes = KECCAK_BATCH_LANES; }
+
+        // A single message has nothing to interleave with
+        if (lanes == 1) {
+            ffx_hash_keccak256(&digests[base * FFX_KECCAK256_DIGEST_LENGTH],
+              inputs[base], lengths[base]);
+            break;
+        }
+
+        memset(state, 0, sizeof(BatchState));
+
+        // Number of blocks (including padding) for each lane
+        size_t blocks[KECCAK_BATCH_LANES] = { 0 };
+        size_t maxBlocks = 0;
+        for (int l = 0; l < lanes; l++) {
+            blocks[l] = 1 + lengths[base + l] / KECCAK256_BLOCK_SIZE;
+            if (blocks[l] > maxBlocks) { maxBlocks = blocks[l]; }
+        }
+
+        for (size_t b = 0; b < maxBlocks; b++) {
+            for (int l = 0; l < lanes; l++) {
+                if (b >= blocks[l]) { continue; }
+                sha3_absorbBatch(state, l, inputs[base + l],
+                  lengths[base + l], b);
+            }
+
+            sha3_permutationBatch(state);
+
+            // Squeeze any lane that just absorbed its final block
+            for (int l = 0; l < lanes; l++) {
+                if (b + 1 != blocks[l]) { continue; }
+
+                uint64_t hash[4];
+                for (int i = 0; i < 4; i++) { hash[i] = state[i][l]; }
+
+                me64_to_le_str(
+                  &digests[(base + l) * FFX_KECCAK256_DIGEST_LENGTH], hash,
+                  FFX_KECCAK256_DIGEST_LENGTH);
+            }
+        }
+    }
+}
+
+#else  /* __x86_64__ */
+
+void ffx_hash_keccak256Batch(uint8_t *digests, const uint8_t * const *inputs,
+  const size_t *lengths, size_t count) {
+
+    for (size_t i = 0; i < count; i++) {
+        ffx_hash_keccak256(&digests[i * FFX_KECCAK256_DIGEST_LENGTH],
+          inputs[i], lengths[i]);
+    }
+}
+
+#endif  /* __x86_64__ */
@@ -61,14 +61,11 @@ static inline void md_pad(uint8_t *block, size_t blocksz, size_t used, size_t ms
   write32_be((uint32_t) (msg * 8), block);
 }
 
-/* Internal function/type names for hash-specific things. */
-#define HMAC_CTX(_name) HMAC_ ## _name ## _ctx
-#define HMAC_INIT(_name) HMAC_ ## _name ## _init
-#define HMAC_UPDATE(_name) HMAC_ ## _name ## _update
-#define HMAC_FINAL(_name) HMAC_ ## _name ## _final
-
-
-#define PBKDF2_F(_name) pbkdf2_f_ ## _name
+#define PBKDF2_BEGIN(_name) pbkdf2_begin_ ## _name
+#define PBKDF2_ITERATE(_name) pbkdf2_iterate_ ## _name
+#define PBKDF2_END(_name) pbkdf2_end_ ## _name
+#define PBKDF2_INIT(_name) pbkdf2_init_ ## _name
+#define PBKDF2_STEP(_name) pbkdf2_step_ ## _name
 #define PBKDF2(_name) pbkdf2_ ## _name
 
 /* This macro expands to decls for the whole implementation for a given
@@ -78,133 +75,100 @@ static inline void md_pad(uint8_t *block, size_t blocksz, size_t used, size_t ms
  * _blocksz block size, in bytes
  * _hashsz digest output, in bytes
  * _ctx hash context type
- * _init hash context initialisation function
- *    args: (_ctx *c)
- * _update hash context update function
- *    args: (_ctx *c, const void *data, size_t ndata)
- * _final hash context finish function
- *    args: (void *out, _ctx *c)
+ * _state PBKDF2 context type (see firefly-hash.h)
+ * _hmac_ctx HMAC context type (see firefly-hash.h)
+ * _hmac_prepare HMAC key preparation function
+ *    args: (_hmac_key *k, const uint8_t *key, size_t nkey)
+ * _hmac_init HMAC context initialisation from a prepared key
+ *    args: (_hmac_ctx *c, const _hmac_key *k)
+ * _hmac_update HMAC context update function
+ *    args: (_hmac_ctx *c, const uint8_t *data, size_t ndata)
+ * _hmac_final HMAC context finish function
+ *    args: (_hmac_ctx *c, uint8_t *out)
  * _xform hash context raw block update function
  *    args: (_ctx *c, const void *data)
- * _xcpy hash context raw copy function (only need copy hash state)
- *    args: (_ctx * restrict out, const _ctx *restrict in)
  * _xtract hash context state extraction
  *    args: args (_ctx *restrict c, uint8_t *restrict out)
  * _xxor hash context xor function (only need xor hash state)
  *    args: (_ctx *restrict out, const _ctx *restrict in)
  *
+ * The HMAC itself is shared with hmac.c; the prepared key holds the
+ * inner and outer midstates, which each iteration restarts from.
+ *
+ * The computation is a state machine over each block of the output,
+ * so it can be advanced a number of iterations at a time; the hot loop
+ * keeps its state in locals and only stores it between steps.
+ *
  * The resulting function is named PBKDF2(_name).
  */
-#define DECL_PBKDF2(_name, _blocksz, _hashsz, _ctx,                           \
-                    _init, _update, _xform, _final, _xcpy, _xtract, _xxor)    \
-  typedef struct {                                                            \
-    _ctx inner;                                                               \
-    _ctx outer;                                                               \
-  } HMAC_CTX(_name);                                                          \
-                                                                              \
-  static inline void HMAC_INIT(_name)(HMAC_CTX(_name) *ctx,                   \
-                                      const uint8_t *key, size_t nkey)        \
-  {                                                                           \
-    /* Prepare key: */                                                        \
-    uint8_t k[_blocksz];                                                      \
-                                                                              \
-    /* Shorten long keys. */                                                  \
-    if (nkey > _blocksz)                                                      \
-    {                                                                         \
-      _init(&ctx->inner);                                                     \
-      _update(&ctx->inner, key, nkey);                                        \
-      _final(k, &ctx->inner);                                                 \
-                                                                              \
-      key = k;                                                                \
-      nkey = _hashsz;                                                         \
-    }                                                                         \
-                                                                              \
-    /* Standard doesn't cover case where blocksz < hashsz. */                 \
-    assert(nkey <= _blocksz);                                                 \
-                                                                              \
-    /* Right zero-pad short keys. */                                          \
-    if (k != key)                                                             \
-      memcpy(k, key, nkey);                                                   \
-    if (_blocksz > nkey)                                                      \
-      memset(k + nkey, 0, _blocksz - nkey);                                   \
-                                                                              \
-    /* Start inner hash computation */                                        \
-    uint8_t blk_inner[_blocksz];                                              \
-    uint8_t blk_outer[_blocksz];                                              \
-                                                                              \
-    for (size_t i = 0; i < _blocksz; i++)                                     \
-    {                                                                         \
-      blk_inner[i] = 0x36 ^ k[i];                                             \
-      blk_outer[i] = 0x5c ^ k[i];                                             \
-    }                                                                         \
-                                                                              \
-    _init(&ctx->inner);                                                       \
-    _update(&ctx->inner, blk_inner, sizeof blk_inner);                        \
-                                                                              \
-    /* And outer. */                                                          \
-    _init(&ctx->outer);                                                       \
-    _update(&ctx->outer, blk_outer, sizeof blk_outer);                        \
-  }                                                                           \
-                                                                              \
-  static inline void HMAC_UPDATE(_name)(HMAC_CTX(_name) *ctx,                 \
-                                        const void *data, size_t ndata)       \
-  {                                                                           \
-    _update(&ctx->inner, data, ndata);                                        \
-  }                                                                           \
-                                                                              \
-  static inline void HMAC_FINAL(_name)(HMAC_CTX(_name) *ctx,                  \
-                                       uint8_t out[_hashsz])                  \
-  {                                                                           \
-    _final(out, &ctx->inner);                                                 \
-    _update(&ctx->outer, out, _hashsz);                                       \
-    _final(out, &ctx->outer);                                                 \
-  }                                                                           \
-                                                                              \
-                                                                              \
+#define DECL_PBKDF2(_name, _blocksz, _hashsz, _ctx, _state, _hmac_ctx,        \
+                    _hmac_prepare, _hmac_init, _hmac_update, _hmac_final,     \
+                    _xform, _xtract, _xxor)                                   \
   /* --- PBKDF2 --- */                                                        \
-  static inline void PBKDF2_F(_name)(const HMAC_CTX(_name) *startctx,         \
-                                     uint32_t counter,                        \
-                                     const uint8_t *salt, size_t nsalt,       \
-                                     uint32_t iterations,                     \
-                                     uint8_t *out)                            \
+  static inline void PBKDF2_BEGIN(_name)(_state *st)                          \
   {                                                                           \
     uint8_t countbuf[4];                                                      \
-    write32_be(counter, countbuf);                                            \
+    write32_be(st->counter, countbuf);                                        \
                                                                               \
     /* Prepare loop-invariant padding block. */                               \
-    uint8_t Ublock[_blocksz];                                                 \
-    md_pad(Ublock, _blocksz, _hashsz, _blocksz + _hashsz);                    \
+    md_pad(st->block, _blocksz, _hashsz, _blocksz + _hashsz);                 \
                                                                               \
     /* First iteration:                                                       \
      *   U_1 = PRF(P, S || INT_32_BE(i))                                      \
      */                                                                       \
-    HMAC_CTX(_name) ctx = *startctx;                                          \
-    HMAC_UPDATE(_name)(&ctx, salt, nsalt);                                    \
-    HMAC_UPDATE(_name)(&ctx, countbuf, sizeof countbuf);                      \
-    HMAC_FINAL(_name)(&ctx, Ublock);                                          \
-    _ctx result = ctx.outer;                                                  \
+    _hmac_ctx hmac;                                                           \
+    _hmac_init(&hmac, &st->key);                                              \
+    _hmac_update(&hmac, st->salt, st->saltLength);                            \
+    _hmac_update(&hmac, countbuf, sizeof countbuf);                           \
+    _hmac_final(&hmac, st->block);                                            \
+    /* The final state of the HMAC context is U_1 */                          \
+    memcpy(st->result, hmac.inner.h, sizeof st->result);                      \
+    st->iteration = 1;                                                        \
+  }                                                                           \
+                                                                              \
+  static inline void PBKDF2_ITERATE(_name)(_state *st, uint32_t count)        \
+  {                                                                           \
+    _ctx result, ctx;                                                         \
+    memcpy(result.h, st->result, sizeof result.h);                            \
                                                                               \
     /* Subsequent iterations:                                                 \
      *   U_c = PRF(P, U_{c-1})                                                \
      */                                                                       \
-    for (uint32_t i = 1; i < iterations; i++)                                 \
+    for (uint32_t i = 0; i < count; i++)                                      \
     {                                                                         \
       /* Complete inner hash with previous U */                               \
-      _xcpy(&ctx.inner, &startctx->inner);                                    \
-      _xform(&ctx.inner, Ublock);                                             \
-      _xtract(&ctx.inner, Ublock);                                            \
+      memcpy(ctx.h, st->key.inner, sizeof ctx.h);                             \
+      _xform(&ctx, st->block);                                                \
+      _xtract(&ctx, st->block);                                               \
       /* Complete outer hash with inner output */                             \
-      _xcpy(&ctx.outer, &startctx->outer);                                    \
-      _xform(&ctx.outer, Ublock);                                             \
-      _xtract(&ctx.outer, Ublock);                                            \
-      _xxor(&result, &ctx.outer);                                             \
+      memcpy(ctx.h, st->key.outer, sizeof ctx.h);                             \
+      _xform(&ctx, st->block);                                                \
+      _xtract(&ctx, st->block);                                               \
+      _xxor(&result, &ctx);                                                   \
     }                                                                         \
                                                                               \
+    memcpy(st->result, result.h, sizeof st->result);                          \
+    st->iteration += count;                                                   \
+  }                                                                           \
+                                                                              \
+  static inline void PBKDF2_END(_name)(_state *st)                            \
+  {                                                                           \
     /* Reform result into output buffer. */                                   \
-    _xtract(&result, out);                                                    \
+    _ctx result;                                                              \
+    uint8_t block[_hashsz];                                                   \
+    memcpy(result.h, st->result, sizeof result.h);                            \
+    _xtract(&result, block);                                                  \
+                                                                              \
+    size_t offset = (st->counter - 1) * _hashsz;                              \
+    size_t taken = MIN(st->dkLength - offset, _hashsz);                       \
+    memcpy(st->dkOut + offset, block, taken);                                 \
+                                                                              \
+    st->counter++;                                                            \
+    st->iteration = 0;                                                        \
   }                                                                           \
                                                                               \
-  static inline void PBKDF2(_name)(const uint8_t *pw, size_t npw,             \
+  static inline void PBKDF2_INIT(_name)(_state *st,                           \
+                     const uint8_t *pw, size_t npw,                           \
                      const uint8_t *salt, size_t nsalt,                       \
                      uint32_t iterations,                                     \
                      uint8_t *out, size_t nout)                               \
@@ -213,21 +177,54 @@ static inline void md_pad(uint8_t *block, size_t blocksz, size_t used, size_t ms
     assert(out && nout);                                                      \
                                                                               \
     /* Starting point for inner loop. */                                      \
-    HMAC_CTX(_name) ctx;                                                      \
-    HMAC_INIT(_name)(&ctx, pw, npw);                                          \
+    _hmac_prepare(&st->key, pw, npw);                                         \
                                                                               \
+    st->salt = salt;                                                          \
+    st->saltLength = nsalt;                                                   \
+    st->dkOut = out;                                                          \
+    st->dkLength = nout;                                                      \
+    st->iterations = iterations;                                              \
+    st->counter = 1;                                                          \
+    st->iteration = 0;                                                        \
+  }                                                                           \
+                                                                              \
+  /* Returns true once the final block is complete */                         \
+  static inline bool PBKDF2_STEP(_name)(_state *st, uint32_t count)           \
+  {                                                                           \
     /* How many blocks do we need? */                                         \
-    uint32_t blocks_needed = (uint32_t)(nout + _hashsz - 1) / _hashsz;        \
+    uint32_t blocks_needed = (uint32_t)(st->dkLength + _hashsz - 1) / _hashsz;\
                                                                               \
-    for (uint32_t counter = 1; counter <= blocks_needed; counter++)           \
+    while (st->counter <= blocks_needed)                                      \
     {                                                                         \
-      uint8_t block[_hashsz];                                                 \
-      PBKDF2_F(_name)(&ctx, counter, salt, nsalt, iterations, block);         \
+      if (st->iteration == 0)                                                 \
+      {                                                                       \
+        if (count == 0)                                                       \
+          return false;                                                       \
+        PBKDF2_BEGIN(_name)(st);                                              \
+        count--;                                                              \
+      }                                                                       \
                                                                               \
-      size_t offset = (counter - 1) * _hashsz;                                \
-      size_t taken = MIN(nout - offset, _hashsz);                             \
-      memcpy(out + offset, block, taken);                                     \
+      uint32_t todo = MIN(count, st->iterations - st->iteration);             \
+      PBKDF2_ITERATE(_name)(st, todo);                                        \
+      count -= todo;                                                          \
+                                                                              \
+      if (st->iteration < st->iterations)                                     \
+        return false;                                                         \
+                                                                              \
+      PBKDF2_END(_name)(st);                                                  \
     }                                                                         \
+                                                                              \
+    return true;                                                              \
+  }                                                                           \
+                                                                              \
+  static inline void PBKDF2(_name)(const uint8_t *pw, size_t npw,             \
+                     const uint8_t *salt, size_t nsalt,                       \
+                     uint32_t iterations,                                     \
+                     uint8_t *out, size_t nout)                               \
+  {                                                                           \
+    _state st;                                                                \
+    PBKDF2_INIT(_name)(&st, pw, npw, salt, nsalt, iterations, out, nout);     \
+    while (!PBKDF2_STEP(_name)(&st, UINT32_MAX)) { }                          \
   }
 
 static inline void sha256_extract(FfxSha256Context *restrict ctx, uint8_t *restrict out)
@@ -242,18 +239,6 @@ static inline void sha256_extract(FfxSha256Context *restrict ctx, uint8_t *restr
   write32_be(ctx->h[7], out + 28);
 }
 
-static inline void sha256_cpy(FfxSha256Context *restrict out, const FfxSha256Context *restrict in)
-{
-  out->h[0] = in->h[0];
-  out->h[1] = in->h[1];
-  out->h[2] = in->h[2];
-  out->h[3] = in->h[3];
-  out->h[4] = in->h[4];
-  out->h[5] = in->h[5];
-  out->h[6] = in->h[6];
-  out->h[7] = in->h[7];
-}
-
 static inline void sha256_xor(FfxSha256Context *restrict out, const FfxSha256Context *restrict in)
 {
   out->h[0] ^= in->h[0];
@@ -270,19 +255,17 @@ static inline void sha256_xor(FfxSha256Context *restrict out, const FfxSha256Con
 // See: sha2.c
 void _ffx_hash_xformSha256(FfxSha256Context *ctx, const uint8_t *message);
 
-static void sha256_final(uint8_t *out, FfxSha256Context *ctx) {
-    ffx_hash_finalSha256(ctx, out);
-}
-
 DECL_PBKDF2(sha256,
             _ffx_sha256_block_length,
             FFX_SHA256_DIGEST_LENGTH,
             FfxSha256Context,
-            ffx_hash_initSha256,
-            ffx_hash_updateSha256,
+            FfxPbkdf2Sha256Context,
+            FfxHmacSha256Context,
+            ffx_hmac_initSha256Key,
+            ffx_hmac_initSha256WithKey,
+            ffx_hmac_updateSha256,
+            ffx_hmac_finalSha256,
             _ffx_hash_xformSha256,
-            sha256_final,
-            sha256_cpy,
             sha256_extract,
             sha256_xor)
 
@@ -298,18 +281,6 @@ static inline void sha512_extract(FfxSha512Context *restrict ctx, uint8_t *restr
   write64_be(ctx->h[7], out + 56);
 }
 
-static inline void sha512_cpy(FfxSha512Context *restrict out, const FfxSha512Context *restrict in)
-{
-  out->h[0] = in->h[0];
-  out->h[1] = in->h[1];
-  out->h[2] = in->h[2];
-  out->h[3] = in->h[3];
-  out->h[4] = in->h[4];
-  out->h[5] = in->h[5];
-  out->h[6] = in->h[6];
-  out->h[7] = in->h[7];
-}
-
 static inline void sha512_xor(FfxSha512Context *restrict out, const FfxSha512Context *restrict in)
 {
   out->h[0] ^= in->h[0];
@@ -325,19 +296,17 @@ static inline void sha512_xor(FfxSha512Context *restrict out, const FfxSha512Con
 // See: sha2.c
 void _ffx_hash_xformSha512(FfxSha512Context *ctx, const uint8_t *message);
 
-static void sha512_final(uint8_t *out, FfxSha512Context *ctx) {
-    ffx_hash_finalSha512(ctx, out);
-}
-
 DECL_PBKDF2(sha512,
             _ffx_sha512_block_length,
             FFX_SHA512_DIGEST_LENGTH,
             FfxSha512Context,
-            ffx_hash_initSha512,
-            ffx_hash_updateSha512,
+            FfxPbkdf2Sha512Context,
+            FfxHmacSha512Context,
+            ffx_hmac_initSha512Key,
+            ffx_hmac_initSha512WithKey,
+            ffx_hmac_updateSha512,
+            ffx_hmac_finalSha512,
             _ffx_hash_xformSha512,
-            sha512_final,
-            sha512_cpy,
             sha512_extract,
             sha512_xor)
 
@@ -355,3 +324,246 @@ void ffx_pbkdf2_sha512(uint8_t *dkOut, size_t dkLength, uint32_t iterations,
     PBKDF2(sha512)(passwd, passwdLength, salt, saltLength, iterations,
       dkOut, dkLength);
 }
+
+
+void ffx_pbkdf2_initSha256(FfxPbkdf2Sha256Context *context, uint8_t *dkOut,
+  size_t dkLength, uint32_t iterations, const uint8_t *passwd,
+  size_t passwdLength, const uint8_t *salt, size_t saltLength) {
+    PBKDF2_INIT(sha256)(context, passwd, passwdLength, salt, saltLength,
+      iterations, dkOut, dkLength);
+}
+
+bool ffx_pbkdf2_stepSha256(FfxPbkdf2Sha256Context *context, uint32_t count) {
+    return PBKDF2_STEP(sha256)(context, count);
+}
+
+void ffx_pbkdf2_finalSha256(FfxPbkdf2Sha256Context *context) {
+    while (!PBKDF2_STEP(sha256)(context, UINT32_MAX)) { }
+    memset(context, 0, sizeof(FfxPbkdf2Sha256Context));
+}
+
+uint32_t ffx_pbkdf2_getProgressSha256(const FfxPbkdf2Sha256Context *context,
+  uint32_t *total) {
+
+    if (total) {
+        uint32_t blocks = (context->dkLength + FFX_SHA256_DIGEST_LENGTH - 1) /
+          FFX_SHA256_DIGEST_LENGTH;
+        *total = blocks * context->iterations;
+    }
+
+    return (context->counter - 1) * context->iterations + context->iteration;
+}
+
+bool ffx_pbkdf2_sha256WithProgress(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t *passwd, size_t passwdLength,
+  const uint8_t *salt, size_t saltLength, uint32_t interval,
+  FfxPbkdf2ProgressFunc progress, void *arg) {
+
+    FfxPbkdf2Sha256Context ctx;
+    ffx_pbkdf2_initSha256(&ctx, dkOut, dkLength, iterations, passwd,
+      passwdLength, salt, saltLength);
+
+    bool complete = false;
+    while (!complete) {
+        complete = ffx_pbkdf2_stepSha256(&ctx, interval ? interval: 1);
+
+        uint32_t total = 0;
+        uint32_t completed = ffx_pbkdf2_getProgressSha256(&ctx, &total);
+        if (!progress(completed, total, arg)) { break; }
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+
+    return complete;
+}
+
+
+void ffx_pbkdf2_initSha512(FfxPbkdf2Sha512Context *context, uint8_t *dkOut,
+  size_t dkLength, uint32_t iterations, const uint8_t *passwd,
+  size_t passwdLength, const uint8_t *salt, size_t saltLength) {
+    PBKDF2_INIT(sha512)(context, passwd, passwdLength, salt, saltLength,
+      iterations, dkOut, dkLength);
+}
+
+bool ffx_pbkdf2_stepSha512(FfxPbkdf2Sha512Context *context, uint32_t count) {
+    return PBKDF2_STEP(sha512)(context, count);
+}
+
+void ffx_pbkdf2_finalSha512(FfxPbkdf2Sha512Context *context) {
+    while (!PBKDF2_STEP(sha512)(context, UINT32_MAX)) { }
+    memset(context, 0, sizeof(FfxPbkdf2Sha512Context));
+}
+
+uint32_t ffx_pbkdf2_getProgressSha512(const FfxPbkdf2Sha512Context *context,
+  uint32_t *total) {
+
+    if (total) {
+        uint32_t blocks = (context->dkLength + FFX_SHA512_DIGEST_LENGTH - 1) /
+          FFX_SHA512_DIGEST_LENGTH;
+        *total = blocks * context->iterations;
+    }
+
+    return (context->counter - 1) * context->iterations + context->iteration;
+}
+
+bool ffx_pbkdf2_sha512WithProgress(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t *passwd, size_t passwdLength,
+  const uint8_t *salt, size_t saltLength, uint32_t interval,
+  FfxPbkdf2ProgressFunc progress, void *arg) {
+
+    FfxPbkdf2Sha512Context ctx;
+    ffx_pbkdf2_initSha512(&ctx, dkOut, dkLength, iterations, passwd,
+      passwdLength, salt, saltLength);
+
+    bool complete = false;
+    while (!complete) {
+        complete = ffx_pbkdf2_stepSha512(&ctx, interval ? interval: 1);
+
+        uint32_t total = 0;
+        uint32_t completed = ffx_pbkdf2_getProgressSha512(&ctx, &total);
+        if (!progress(completed, total, arg)) { break; }
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+
+    return complete;
+}
+
+
+/**
+ *  Multi-lane PBKDF2-HMAC-SHA512.
+ *
+ *  After the first iteration, each iteration is exactly two compressions
+ *  of a single padded block (starting from the inner and outer key
+ *  midstates), so the iterations of independent computations can run in
+ *  lock-step, one per SIMD lane. The key setup and first iteration of
+ *  each lane are computed as usual.
+ *
+ *  Elsewhere (i.e. on device), each computation is simply run in turn.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+#define LANES      (_ffx_sha512_lanes)
+
+// See: sha2.c
+void _ffx_hash_xformSha512Lanes(uint64_t *h, const uint64_t *w);
+
+static void pbkdf2_sha512_lanes(const FfxHmacSha512Key *keys,
+                                size_t lanes, uint32_t counter,
+                                const uint8_t * const *salts,
+                                const size_t *nsalts, uint32_t iterations,
+                                uint8_t *out, size_t nout)
+{
+  uint64_t inner[8 * LANES], outer[8 * LANES];
+  uint64_t result[8 * LANES], state[8 * LANES];
+  uint64_t block[16 * LANES];
+
+  uint8_t countbuf[4];
+  write32_be(counter, countbuf);
+
+  /* The padding of the single-block message (the previous U) */
+  memset(block, 0, sizeof block);
+  for (size_t l = 0; l < LANES; l++)
+  {
+    block[8 * LANES + l] = 0x8000000000000000ULL;
+    block[15 * LANES + l] = (_ffx_sha512_block_length +
+                             FFX_SHA512_DIGEST_LENGTH) * 8;
+  }
+
+  /* First iteration; unused lanes repeat the first lane */
+  for (size_t l = 0; l < LANES; l++)
+  {
+    size_t src = (l < lanes) ? l : 0;
+
+    uint8_t U[FFX_SHA512_DIGEST_LENGTH];
+    FfxHmacSha512Context hmac;
+    ffx_hmac_initSha512WithKey(&hmac, &keys[src]);
+    ffx_hmac_updateSha512(&hmac, salts[src], nsalts[src]);
+    ffx_hmac_updateSha512(&hmac, countbuf, sizeof countbuf);
+    ffx_hmac_finalSha512(&hmac, U);
+
+    for (size_t i = 0; i < 8; i++)
+    {
+      inner[i * LANES + l] = keys[src].inner[i];
+      outer[i * LANES + l] = keys[src].outer[i];
+      result[i * LANES + l] = hmac.inner.h[i];
+      block[i * LANES + l] = hmac.inner.h[i];
+    }
+  }
+
+  /* Subsequent iterations */
+  for (uint32_t i = 1; i < iterations; i++)
+  {
+    memcpy(state, inner, sizeof state);
+    _ffx_hash_xformSha512Lanes(state, block);
+    memcpy(block, state, sizeof state);
+
+    memcpy(state, outer, sizeof state);
+    _ffx_hash_xformSha512Lanes(state, block);
+    memcpy(block, state, sizeof state);
+
+    for (size_t j = 0; j < 8 * LANES; j++)
+      result[j] ^= state[j];
+  }
+
+  for (size_t l = 0; l < lanes; l++)
+  {
+    uint8_t U[FFX_SHA512_DIGEST_LENGTH];
+    for (size_t i = 0; i < 8; i++)
+      write64_be(result[i * LANES + l], U + 8 * i);
+
+    size_t offset = (counter - 1) * FFX_SHA512_DIGEST_LENGTH;
+    size_t taken = MIN(nout - offset, FFX_SHA512_DIGEST_LENGTH);
+    memcpy(out + l * nout + offset, U, taken);
+  }
+}
+
+void ffx_pbkdf2_sha512Batch(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t * const *passwds,
+  const size_t *passwdLengths, const uint8_t * const *salts,
+  const size_t *saltLengths, size_t count) {
+
+    for (size_t base = 0; base < count; base += LANES) {
+        size_t lanes = count - base;
+        if (lanes > LANES) { lanes = LANES; }
+
+        // A single computation has nothing to interleave with
+        if (lanes == 1) {
+            ffx_pbkdf2_sha512(&dkOut[base * dkLength], dkLength, iterations,
+              passwds[base], passwdLengths[base], salts[base],
+              saltLengths[base]);
+            break;
+        }
+
+        FfxHmacSha512Key keys[LANES];
+        for (size_t l = 0; l < lanes; l++) {
+            ffx_hmac_initSha512Key(&keys[l], passwds[base + l],
+              passwdLengths[base + l]);
+        }
+
+        uint32_t blocksNeeded = (uint32_t)(dkLength +
+          FFX_SHA512_DIGEST_LENGTH - 1) / FFX_SHA512_DIGEST_LENGTH;
+
+        for (uint32_t counter = 1; counter <= blocksNeeded; counter++) {
+            pbkdf2_sha512_lanes(keys, lanes, counter, &salts[base],
+              &saltLengths[base], iterations, &dkOut[base * dkLength],
+              dkLength);
+        }
+    }
+}
+
+#else  /* __x86_64__ */
+
+void ffx_pbkdf2_sha512Batch(uint8_t *dkOut, size_t dkLength,
+  uint32_t iterations, const uint8_t * const *passwds,
+  const size_t *passwdLengths, const uint8_t * const *salts,
+  const size_t *saltLengths, size_t count) {
+
+    for (size_t i = 0; i < count; i++) {
+        ffx_pbkdf2_sha512(&dkOut[i * dkLength], dkLength, iterations,
+          passwds[i], passwdLengths[i], salts[i], saltLengths[i]);
+    }
+}
+
+#endif  /* __x86_64__ */
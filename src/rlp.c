@@ -347,17 +347,11 @@ static size_t getByteCount(size_t value) {
     return 4;
 }
 
-static bool appendByte(FfxRlpBuilder *rlp, uint8_t byte) {
-
-    if (rlp->error) { return false; }
-
-    if (rlp->length < rlp->offset + 1) {
-        rlp->error = FfxDataErrorBufferOverrun;
-        return false;
-    }
-
-    rlp->data[rlp->offset++] = byte;
-    return true;
+// Returns the length of the header for an item with a payload of
+// %%length%% bytes
+static size_t getHeaderLength(size_t length) {
+    if (length <= 55) { return 1; }
+    return 1 + getByteCount(length);
 }
 
 static bool appendBytes(FfxRlpBuilder *rlp, const uint8_t *data,
@@ -365,6 +359,21 @@ static bool appendBytes(FfxRlpBuilder *rlp, const uint8_t *data,
 
     if (rlp->error) { return false; }
 
+    if (rlp->_mode == FfxRlpBuilderModeStream) {
+        if (rlp->data) {
+            if (rlp->length < rlp->offset + length) {
+                rlp->error = FfxDataErrorBufferOverrun;
+                return false;
+            }
+            memmove(&rlp->data[rlp->offset], data, length);
+        }
+
+        if (rlp->_sink) { ffx_hash_updateKeccak256(rlp->_sink, data, length); }
+
+        rlp->offset += length;
+        return true;
+    }
+
     if (rlp->length < rlp->offset + length) {
         rlp->error = FfxDataErrorBufferOverrun;
         return false;
@@ -375,6 +384,10 @@ static bool appendBytes(FfxRlpBuilder *rlp, const uint8_t *data,
     return true;
 }
 
+static bool appendByte(FfxRlpBuilder *rlp, uint8_t byte) {
+    return appendBytes(rlp, &byte, 1);
+}
+
 // The TAG_RESERVE indicates we are leaving space in the Array. It
 // currently has the number of items in the array, which will need
 // to be swapped out for number of bytes in the final RLP.
@@ -394,15 +407,82 @@ static bool appendHeader(FfxRlpBuilder *rlp, uint8_t tag, size_t length) {
         byteCount = getByteCount(length);
     }
 
-    if (!appendByte(rlp, tag + 55 + byteCount)) { return false; }
+    uint8_t header[5];
+    header[0] = tag + 55 + byteCount;
+    for (int i = 0; i < byteCount; i++) {
+        header[1 + i] = (length >> (8 * (byteCount - 1 - i)));
+    }
+
+    return appendBytes(rlp, header, 1 + byteCount);
+}
+
+// Adds a complete item of %%size%% encoded bytes to the innermost open
+// Array, closing any Arrays which it completes.
+static bool measureItem(FfxRlpBuilder *rlp, size_t size) {
+    if (rlp->error) { return false; }
+
+    while (rlp->_depth) {
+        size_t top = rlp->_depth - 1;
+        size_t index = rlp->_open[top].index;
+
+        rlp->_arrayLengths[index] += size;
+        if (rlp->_arrayLengths[index] > MAX_LENGTH) {
+            rlp->error = FfxDataErrorOverflow;
+            return false;
+        }
+
+        rlp->_open[top].remaining--;
+        if (rlp->_open[top].remaining) { return true; }
 
-    for (int i = byteCount - 1; i >= 0; i--) {
-        if (!appendByte(rlp, (length >> (8 * i)))) { return false; }
+        // The Array is complete, and is itself an item of its parent
+        size = getHeaderLength(rlp->_arrayLengths[index]) +
+          rlp->_arrayLengths[index];
+        rlp->_depth--;
     }
 
+    rlp->offset += size;
     return true;
 }
 
+static bool measureArray(FfxRlpBuilder *rlp, size_t count) {
+    if (rlp->error) { return false; }
+
+    // Empty Arrays are a single byte and do not require a length
+    if (count == 0) { return measureItem(rlp, 1); }
+
+    if (rlp->_arrayIndex >= rlp->_arrayCount) {
+        rlp->error = FfxDataErrorBufferOverrun;
+        return false;
+    }
+
+    if (rlp->_depth >= FFX_RLP_MAX_DEPTH) {
+        rlp->error = FfxDataErrorOverflow;
+        return false;
+    }
+
+    rlp->_arrayLengths[rlp->_arrayIndex] = 0;
+    rlp->_open[rlp->_depth].index = rlp->_arrayIndex;
+    rlp->_open[rlp->_depth].remaining = count;
+    rlp->_depth++;
+    rlp->_arrayIndex++;
+
+    return true;
+}
+
+static bool streamArray(FfxRlpBuilder *rlp, size_t count) {
+    if (rlp->error) { return false; }
+
+    if (count == 0) { return appendByte(rlp, TAG_ARRAY); }
+
+    if (rlp->_arrayIndex >= rlp->_arrayCount) {
+        rlp->error = FfxDataErrorBufferOverrun;
+        return false;
+    }
+
+    return appendHeader(rlp, TAG_ARRAY,
+      rlp->_arrayLengths[rlp->_arrayIndex++]);
+}
+
 
 ///////////////////////////////
 // Building
@@ -411,11 +491,43 @@ FfxRlpBuilder ffx_rlp_build(uint8_t *data, size_t length) {
     return (FfxRlpBuilder){ .data = data, .length = length };
 }
 
+FfxRlpBuilder ffx_rlp_buildMeasure(size_t *arrayLengths, size_t count) {
+    return (FfxRlpBuilder){
+        ._mode = FfxRlpBuilderModeMeasure,
+        ._arrayLengths = arrayLengths,
+        ._arrayCount = count
+    };
+}
+
+size_t ffx_rlp_getMeasuredArrayCount(FfxRlpBuilder *rlp) {
+    return rlp->_arrayIndex;
+}
+
+FfxRlpBuilder ffx_rlp_buildStream(uint8_t *data, size_t length,
+  FfxKeccak256Context *sink, const size_t *arrayLengths, size_t count) {
+
+    return (FfxRlpBuilder){
+        .data = data,
+        .length = length,
+        ._mode = FfxRlpBuilderModeStream,
+        ._sink = sink,
+
+        // Only read while streaming
+        ._arrayLengths = (size_t*)arrayLengths,
+        ._arrayCount = count
+    };
+}
+
 bool ffx_rlp_appendData(FfxRlpBuilder *rlp, const uint8_t *data,
   size_t length) {
 
     if (rlp->error) { return false; }
 
+    if (rlp->_mode == FfxRlpBuilderModeMeasure) {
+        if (length == 1 && data[0] <= 127) { return measureItem(rlp, 1); }
+        return measureItem(rlp, getHeaderLength(length) + length);
+    }
+
     if (length == 1 && data[0] <= 127) {
         return appendByte(rlp, data[0]);
     }
@@ -425,11 +537,29 @@ bool ffx_rlp_appendData(FfxRlpBuilder *rlp, const uint8_t *data,
     return appendBytes(rlp, data, length);
 }
 
+bool ffx_rlp_appendRlp(FfxRlpBuilder *rlp, const uint8_t *data,
+  size_t length) {
+
+    if (rlp->error) { return false; }
+
+    if (rlp->_mode == FfxRlpBuilderModeMeasure) {
+        return measureItem(rlp, length);
+    }
+
+    return appendBytes(rlp, data, length);
+}
+
 bool ffx_rlp_appendString(FfxRlpBuilder *rlp, const char *data) {
     return ffx_rlp_appendData(rlp, (uint8_t*)data, strlen(data));
 }
 
 bool ffx_rlp_appendArray(FfxRlpBuilder *rlp, size_t count) {
+    if (rlp->_mode == FfxRlpBuilderModeMeasure) {
+        return measureArray(rlp, count);
+    } else if (rlp->_mode == FfxRlpBuilderModeStream) {
+        return streamArray(rlp, count);
+    }
+
     // Zero-length arrays can be stored directly in their compact
     // representation. Otherwise we reserve 4 bytes where we include
     // the length in items to fix in finalize
@@ -438,6 +568,12 @@ bool ffx_rlp_appendArray(FfxRlpBuilder *rlp, size_t count) {
 
 FfxRlpBuilderTag ffx_rlp_appendMutableArray(FfxRlpBuilder *rlp) {
 
+    // The count is required up front to measure or stream
+    if (rlp->_mode != FfxRlpBuilderModeBuild) {
+        if (!rlp->error) { rlp->error = FfxDataErrorUnsupportedFeature; }
+        return 0;
+    }
+
     size_t tag = rlp->offset;
     if (!appendHeader(rlp, TAG_RESERVE, 0)) { return 0; }
     return tag;
@@ -504,6 +640,18 @@ static size_t finalize(FfxRlpBuilder *rlp) {
 size_t ffx_rlp_finalize(FfxRlpBuilder *rlp) {
     if (rlp->error) { return 0; }
 
+    if (rlp->_mode == FfxRlpBuilderModeMeasure) {
+        // Some Array did not receive all its items
+        if (rlp->_depth) {
+            rlp->error = FfxDataErrorBadData;
+            return 0;
+        }
+        return rlp->offset;
+    }
+
+    // Streamed data is already complete
+    if (rlp->_mode == FfxRlpBuilderModeStream) { return rlp->offset; }
+
     // Store the non-compact length to minimize compaction memmoves
     rlp->length = rlp->offset;
 
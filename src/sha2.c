@@ -208,8 +208,8 @@ uint64_t sha512_k[80] =
 
 /* SHA-256 functions */
 
-static void sha256_transf(FfxSha256Context *ctx, const uint8_t *message,
-                   size_t block_nb)
+static void sha256_transfPortable(FfxSha256Context *ctx,
+                   const uint8_t *message, size_t block_nb)
 {
     uint32_t w[64];
     uint32_t wv[8];
@@ -254,6 +254,190 @@ static void sha256_transf(FfxSha256Context *ctx, const uint8_t *message,
     }
 }
 
+/**
+ *  SHA-NI
+ *
+ *  On x86-64 hosts with the SHA extensions, the rounds and message
+ *  schedule are computed by the CPU (sha256rnds2, sha256msg1 and
+ *  sha256msg2), 4 rounds at a time. The state is kept in the ABEF/CDGH
+ *  order those instructions expect, so is shuffled on entry and exit.
+ *
+ *  The backend is selected (via CPUID) on first use, and may be queried
+ *  or forced with ffx_hash_getSha256Backend and ffx_hash_setSha256Backend.
+ *
+ *  Elsewhere (i.e. on device), the portable implementation is used.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+#define SHA256_SHANI
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define SHANI_K(g)    _mm_loadu_si128((const __m128i*)&sha256_k[(g) << 2])
+
+/* 4 rounds using the schedule words in cur, advancing the schedule of
+ * next and prev, which are needed 1 and 3 rounds from now respectively */
+#define SHANI_QUAD(g, cur, next, prev)                    \
+{                                                         \
+    msg = _mm_add_epi32(cur, SHANI_K(g));                 \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);  \
+    if ((g) >= 3 && (g) < 15) {                           \
+        tmp = _mm_alignr_epi8(cur, prev, 4);              \
+        next = _mm_add_epi32(next, tmp);                  \
+        next = _mm_sha256msg2_epu32(next, cur);           \
+    }                                                     \
+    msg = _mm_shuffle_epi32(msg, 0x0e);                   \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);  \
+    if ((g) >= 1 && (g) < 13) {                           \
+        prev = _mm_sha256msg1_epu32(prev, cur);           \
+    }                                                     \
+}
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_transfShaNi(FfxSha256Context *ctx,
+                   const uint8_t *message, size_t block_nb)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL,
+                                        0x0405060700010203ULL);
+
+    __m128i state0, state1, save0, save1;
+    __m128i msg, tmp, msg0, msg1, msg2, msg3;
+    size_t i;
+
+    /* ABCD EFGH => ABEF CDGH */
+    tmp = _mm_loadu_si128((const __m128i*)&ctx->h[0]);
+    state1 = _mm_loadu_si128((const __m128i*)&ctx->h[4]);
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (i = 0; i < block_nb; i++) {
+        const uint8_t *sub_block = message + (i << 6);
+
+        save0 = state0;
+        save1 = state1;
+
+        msg0 = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i*)&sub_block[0]), mask);
+        msg1 = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i*)&sub_block[16]), mask);
+        msg2 = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i*)&sub_block[32]), mask);
+        msg3 = _mm_shuffle_epi8(
+          _mm_loadu_si128((const __m128i*)&sub_block[48]), mask);
+
+        SHANI_QUAD( 0, msg0, msg1, msg3);
+        SHANI_QUAD( 1, msg1, msg2, msg0);
+        SHANI_QUAD( 2, msg2, msg3, msg1);
+        SHANI_QUAD( 3, msg3, msg0, msg2);
+        SHANI_QUAD( 4, msg0, msg1, msg3);
+        SHANI_QUAD( 5, msg1, msg2, msg0);
+        SHANI_QUAD( 6, msg2, msg3, msg1);
+        SHANI_QUAD( 7, msg3, msg0, msg2);
+        SHANI_QUAD( 8, msg0, msg1, msg3);
+        SHANI_QUAD( 9, msg1, msg2, msg0);
+        SHANI_QUAD(10, msg2, msg3, msg1);
+        SHANI_QUAD(11, msg3, msg0, msg2);
+        SHANI_QUAD(12, msg0, msg1, msg3);
+        SHANI_QUAD(13, msg1, msg2, msg0);
+        SHANI_QUAD(14, msg2, msg3, msg1);
+        SHANI_QUAD(15, msg3, msg0, msg2);
+
+        state0 = _mm_add_epi32(state0, save0);
+        state1 = _mm_add_epi32(state1, save1);
+    }
+
+    /* ABEF CDGH => ABCD EFGH */
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128((__m128i*)&ctx->h[0], state0);
+    _mm_storeu_si128((__m128i*)&ctx->h[4], state1);
+}
+
+static int sha256_hasShaNi(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) { return 0; }
+    if (!(ecx & bit_SSSE3) || !(ecx & bit_SSE4_1)) { return 0; }
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) { return 0; }
+    return (ebx & bit_SHA) != 0;
+}
+
+#endif  /* x86-64 */
+
+/*
+ * The active backend; resolved on first use. Hashing may happen on several
+ * threads at once, so it is only accessed atomically (racing first uses
+ * all resolve, and store, the same value).
+ */
+static FfxHashBackend sha256_backend = FfxHashBackendAuto;
+
+static FfxHashBackend sha256_resolveBackend(void)
+{
+#ifdef SHA256_SHANI
+    if (sha256_hasShaNi()) { return FfxHashBackendShaNi; }
+#endif
+    return FfxHashBackendPortable;
+}
+
+FfxHashBackend ffx_hash_getSha256Backend(void)
+{
+    FfxHashBackend backend = __atomic_load_n(&sha256_backend,
+      __ATOMIC_RELAXED);
+    if (backend == FfxHashBackendAuto) {
+        backend = sha256_resolveBackend();
+        __atomic_store_n(&sha256_backend, backend, __ATOMIC_RELAXED);
+    }
+    return backend;
+}
+
+bool ffx_hash_setSha256Backend(FfxHashBackend backend)
+{
+    switch (backend) {
+        case FfxHashBackendAuto:
+            __atomic_store_n(&sha256_backend, sha256_resolveBackend(),
+              __ATOMIC_RELAXED);
+            return true;
+
+        case FfxHashBackendPortable:
+            __atomic_store_n(&sha256_backend, backend, __ATOMIC_RELAXED);
+            return true;
+
+#ifdef SHA256_SHANI
+        case FfxHashBackendShaNi:
+            if (!sha256_hasShaNi()) { return false; }
+            __atomic_store_n(&sha256_backend, backend, __ATOMIC_RELAXED);
+            return true;
+#endif
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+static void sha256_transf(FfxSha256Context *ctx, const uint8_t *message,
+                   size_t block_nb)
+{
+#ifdef SHA256_SHANI
+    if (ffx_hash_getSha256Backend() == FfxHashBackendShaNi) {
+        sha256_transfShaNi(ctx, message, block_nb);
+        return;
+    }
+#endif
+
+    sha256_transfPortable(ctx, message, block_nb);
+}
+
 void _ffx_hash_xformSha256(FfxSha256Context *ctx, const uint8_t *message) {
     sha256_transf(ctx, message, 1);
 }
@@ -283,34 +467,47 @@ void ffx_hash_updateSha256(FfxSha256Context *ctx, const uint8_t *message,
                    size_t len)
 {
     size_t block_nb;
-    size_t new_len, rem_len, tmp_len;
-    const uint8_t *shifted_message;
+    size_t rem_len, tmp_len;
 
-    tmp_len = _ffx_sha256_block_length - ctx->len;
-    rem_len = len < tmp_len ? len : tmp_len;
+    /* top up a partially filled block */
+    if (ctx->len) {
+        tmp_len = _ffx_sha256_block_length - ctx->len;
 
-    memcpy(&ctx->block[ctx->len], message, rem_len);
-
-    if (ctx->len + len < _ffx_sha256_block_length) {
-        ctx->len += len;
-        return;
-    }
-
-    new_len = len - rem_len;
-    block_nb = new_len / _ffx_sha256_block_length;
-
-    shifted_message = message + rem_len;
+        if (len < tmp_len) {
+            memcpy(&ctx->block[ctx->len], message, len);
+            ctx->len += len;
+            return;
+        }
 
-    sha256_transf(ctx, ctx->block, 1);
-    sha256_transf(ctx, shifted_message, block_nb);
+        memcpy(&ctx->block[ctx->len], message, tmp_len);
+        sha256_transf(ctx, ctx->block, 1);
+        ctx->tot_len += _ffx_sha256_block_length;
 
-    rem_len = new_len % _ffx_sha256_block_length;
+        message += tmp_len;
+        len -= tmp_len;
+        ctx->len = 0;
+    }
 
-    memcpy(ctx->block, &shifted_message[block_nb << 6],
-           rem_len);
+    /* full blocks are processed directly from the message */
+    block_nb = len / _ffx_sha256_block_length;
+    if (block_nb) {
+        sha256_transf(ctx, message, block_nb);
+        ctx->tot_len += block_nb << 6;
+    }
 
+    /* save leftovers */
+    rem_len = len % _ffx_sha256_block_length;
+    memcpy(ctx->block, &message[block_nb << 6], rem_len);
     ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 6;
+}
+
+void ffx_hash_updateSegmentsSha256(FfxSha256Context *ctx,
+                   const FfxHashSegment *segments, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++) {
+        ffx_hash_updateSha256(ctx, segments[i].data, segments[i].length);
+    }
 }
 
 void ffx_hash_finalSha256(FfxSha256Context *ctx, uint8_t *digest)
@@ -338,8 +535,261 @@ void ffx_hash_finalSha256(FfxSha256Context *ctx, uint8_t *digest)
     }
 }
 
+/**
+ *  Multi-buffer SHA-256.
+ *
+ *  On x86-64 hosts, independent messages are hashed in groups of
+ *  SHA256_BATCH_LANES, with each state and schedule word stored as a
+ *  vector of lanes, so the dependency chain of each round is shared by
+ *  every message in the group. The transform is compiled for AVX2 and
+ *  the baseline ISA, and the loader selects one for the running CPU.
+ *
+ *  A single SHA-NI hash of a short message is faster than its share of
+ *  an 8-lane batch, so the batch is only used with the portable backend.
+ *
+ *  Elsewhere (i.e. on device), each message is simply hashed in turn.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+#define SHA256_BATCH_LANES    8
+
+typedef uint32_t BatchWord __attribute__((vector_size(4 * SHA256_BATCH_LANES)));
+
+#define BATCH_ROTR(x, n)   ((x >> n) | (x << (32 - n)))
+
+#define BATCH_F1(x) (BATCH_ROTR(x,  2) ^ BATCH_ROTR(x, 13) ^ BATCH_ROTR(x, 22))
+#define BATCH_F2(x) (BATCH_ROTR(x,  6) ^ BATCH_ROTR(x, 11) ^ BATCH_ROTR(x, 25))
+#define BATCH_F3(x) (BATCH_ROTR(x,  7) ^ BATCH_ROTR(x, 18) ^ (x >>  3))
+#define BATCH_F4(x) (BATCH_ROTR(x, 17) ^ BATCH_ROTR(x, 19) ^ (x >> 10))
+
+/* The schedule is kept as a rolling window of 16 words */
+#define BATCH_SCR(j)                                          \
+{                                                             \
+    w[(j) & 15] += BATCH_F4(w[((j) - 2) & 15]) + w[((j) - 7) & 15] \
+                   + BATCH_F3(w[((j) - 15) & 15]);            \
+}
+
+__attribute__((target_clones("avx2", "default")))
+static void sha256_transfBatch(BatchWord *h, BatchWord *w)
+{
+    BatchWord a, b, c, d, e, f, g, k, t1, t2;
+    BatchWord hh;
+    int j;
+
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+
+    for (j = 0; j < 64; j++) {
+        if (j >= 16) { BATCH_SCR(j); }
+
+        k = (BatchWord){ 0 } + sha256_k[j];
+
+        t1 = hh + BATCH_F2(e) + ((e & f) ^ (~e & g)) + k + w[j & 15];
+        t2 = BATCH_F1(a) + ((a & b) ^ (a & c) ^ (b & c));
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+}
+
+/* Loads the block %%index%% of %%message%% into %%lane%% of %%w%%,
+ * applying the padding to the final blocks of the message */
+static void sha256_loadBatch(BatchWord *w, int lane, const uint8_t *message,
+                   size_t len, size_t index)
+{
+    uint8_t block[_ffx_sha256_block_length];
+    size_t offset = index << 6;
+    size_t len_b;
+    uint32_t word;
+    int j;
+
+    if (offset + _ffx_sha256_block_length <= len) {
+        memcpy(block, &message[offset], _ffx_sha256_block_length);
+    } else {
+        memset(block, 0, _ffx_sha256_block_length);
+        if (offset <= len) {
+            memcpy(block, &message[offset], len - offset);
+            block[len - offset] = 0x80;
+        }
+
+        /* The length is in the final block */
+        if (offset > len || len - offset < _ffx_sha256_block_length - 8) {
+            len_b = len << 3;
+            UNPACK32(len_b, block + _ffx_sha256_block_length - 4);
+            UNPACK32((uint64_t)len_b >> 32,
+              block + _ffx_sha256_block_length - 8);
+        }
+    }
+
+    for (j = 0; j < 16; j++) {
+        PACK32(&block[j << 2], &word);
+        w[j][lane] = word;
+    }
+}
+
+void ffx_hash_sha256Batch(uint8_t *digests, const uint8_t * const *inputs,
+                   const size_t *lengths, size_t count)
+{
+    BatchWord h[8];
+    BatchWord w[16];
+    size_t blocks[SHA256_BATCH_LANES];
+    size_t base, lanes, max_blocks, b;
+    uint32_t word;
+    int i, l;
+
+    if (ffx_hash_getSha256Backend() != FfxHashBackendPortable) {
+        for (base = 0; base < count; base++) {
+            ffx_hash_sha256(&digests[base * FFX_SHA256_DIGEST_LENGTH],
+              inputs[base], lengths[base]);
+        }
+        return;
+    }
+
+    for (base = 0; base < count; base += SHA256_BATCH_LANES) {
+        lanes = count - base;
+        if (lanes > SHA256_BATCH_LANES) { lanes = SHA256_BATCH_LANES; }
+
+        /* A single message has nothing to interleave with */
+        if (lanes == 1) {
+            ffx_hash_sha256(&digests[base * FFX_SHA256_DIGEST_LENGTH],
+              inputs[base], lengths[base]);
+            break;
+        }
+
+        for (i = 0; i < 8; i++) {
+            h[i] = (BatchWord){ 0 } + sha256_h0[i];
+        }
+        memset(w, 0, sizeof(w));
+
+        /* Number of blocks (including padding) for each lane */
+        max_blocks = 0;
+        for (l = 0; l < (int) lanes; l++) {
+            blocks[l] = (lengths[base + l] + 8) / _ffx_sha256_block_length + 1;
+            if (blocks[l] > max_blocks) { max_blocks = blocks[l]; }
+        }
+
+        for (b = 0; b < max_blocks; b++) {
+            for (l = 0; l < (int) lanes; l++) {
+                if (b >= blocks[l]) { continue; }
+                sha256_loadBatch(w, l, inputs[base + l], lengths[base + l], b);
+            }
+
+            sha256_transfBatch(h, w);
+
+            /* Output any lane that just processed its final block */
+            for (l = 0; l < (int) lanes; l++) {
+                if (b + 1 != blocks[l]) { continue; }
+                for (i = 0; i < 8; i++) {
+                    word = h[i][l];
+                    UNPACK32(word, &digests[(base + l) *
+                      FFX_SHA256_DIGEST_LENGTH + (i << 2)]);
+                }
+            }
+        }
+    }
+}
+
+#else  /* __x86_64__ */
+
+void ffx_hash_sha256Batch(uint8_t *digests, const uint8_t * const *inputs,
+                   const size_t *lengths, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++) {
+        ffx_hash_sha256(&digests[i * FFX_SHA256_DIGEST_LENGTH],
+          inputs[i], lengths[i]);
+    }
+}
+
+#endif  /* __x86_64__ */
+
 /* SHA-512 functions */
 
+/**
+ *  The SHA-512 transform is available in two variants, selected at
+ *  build time:
+ *    - compact (default); a full 80-word schedule and a rotating
+ *      working state, to keep flash usage low on device
+ *    - unrolled (FFX_SHA512_UNROLLED); 16 rounds per loop iteration,
+ *      with the working state renamed rather than rotated and the
+ *      schedule computed just ahead of use in a rolling 16-word window
+ */
+
+#ifdef FFX_SHA512_UNROLLED
+
+/* Expands schedule word j in place, in the 16-word rolling window */
+#define SHA512_SCR16(j)                                       \
+    (w[(j) & 15] += SHA512_F4(w[((j) - 2) & 15])              \
+                    + w[((j) - 7) & 15]                       \
+                    + SHA512_F3(w[((j) - 15) & 15]))
+
+/* A single round; d and h are updated, and the caller renames the
+ * remaining variables rather than shifting them. CH and MAJ use the
+ * equivalent forms with fewer operations */
+#define SHA512_RND(a, b, c, d, e, f, g, h, j, wj)             \
+{                                                             \
+    t1 = h + SHA512_F2(e) + (g ^ (e & (f ^ g))) + sha512_k[j] + (wj); \
+    d += t1;                                                  \
+    h = t1 + SHA512_F1(a) + (b ^ ((a ^ b) & (b ^ c)));        \
+}
+
+#define SHA512_RND16(j, W)                                    \
+{                                                             \
+    SHA512_RND(a, b, c, d, e, f, g, h, (j) +  0, W((j) +  0)) \
+    SHA512_RND(h, a, b, c, d, e, f, g, (j) +  1, W((j) +  1)) \
+    SHA512_RND(g, h, a, b, c, d, e, f, (j) +  2, W((j) +  2)) \
+    SHA512_RND(f, g, h, a, b, c, d, e, (j) +  3, W((j) +  3)) \
+    SHA512_RND(e, f, g, h, a, b, c, d, (j) +  4, W((j) +  4)) \
+    SHA512_RND(d, e, f, g, h, a, b, c, (j) +  5, W((j) +  5)) \
+    SHA512_RND(c, d, e, f, g, h, a, b, (j) +  6, W((j) +  6)) \
+    SHA512_RND(b, c, d, e, f, g, h, a, (j) +  7, W((j) +  7)) \
+    SHA512_RND(a, b, c, d, e, f, g, h, (j) +  8, W((j) +  8)) \
+    SHA512_RND(h, a, b, c, d, e, f, g, (j) +  9, W((j) +  9)) \
+    SHA512_RND(g, h, a, b, c, d, e, f, (j) + 10, W((j) + 10)) \
+    SHA512_RND(f, g, h, a, b, c, d, e, (j) + 11, W((j) + 11)) \
+    SHA512_RND(e, f, g, h, a, b, c, d, (j) + 12, W((j) + 12)) \
+    SHA512_RND(d, e, f, g, h, a, b, c, (j) + 13, W((j) + 13)) \
+    SHA512_RND(c, d, e, f, g, h, a, b, (j) + 14, W((j) + 14)) \
+    SHA512_RND(b, c, d, e, f, g, h, a, (j) + 15, W((j) + 15)) \
+}
+
+#define SHA512_W_LOAD(j)      (w[(j)])
+#define SHA512_W_EXPAND(j)    SHA512_SCR16(j)
+
+static void sha512_transf(FfxSha512Context *ctx, const uint8_t *message,
+                   size_t block_nb)
+{
+    uint64_t w[16];
+    uint64_t a, b, c, d, e, f, g, h;
+    uint64_t t1;
+    const uint8_t *sub_block;
+    int i, j;
+
+    for (i = 0; i < (int) block_nb; i++) {
+        sub_block = message + (i << 7);
+
+        for (j = 0; j < 16; j++) {
+            PACK64(&sub_block[j << 3], &w[j]);
+        }
+
+        a = ctx->h[0]; b = ctx->h[1]; c = ctx->h[2]; d = ctx->h[3];
+        e = ctx->h[4]; f = ctx->h[5]; g = ctx->h[6]; h = ctx->h[7];
+
+        SHA512_RND16(0, SHA512_W_LOAD);
+        for (j = 16; j < 80; j += 16) {
+            SHA512_RND16(j, SHA512_W_EXPAND);
+        }
+
+        ctx->h[0] += a; ctx->h[1] += b; ctx->h[2] += c; ctx->h[3] += d;
+        ctx->h[4] += e; ctx->h[5] += f; ctx->h[6] += g; ctx->h[7] += h;
+    }
+}
+
+#else  /* FFX_SHA512_UNROLLED */
+
 static void sha512_transf(FfxSha512Context *ctx, const uint8_t *message,
                    size_t block_nb)
 {
@@ -384,10 +834,82 @@ static void sha512_transf(FfxSha512Context *ctx, const uint8_t *message,
     }
 }
 
+#endif  /* FFX_SHA512_UNROLLED */
+
 void _ffx_hash_xformSha512(FfxSha512Context *ctx, const uint8_t *message) {
     sha512_transf(ctx, message, 1);
 }
 
+/**
+ *  Multi-lane SHA-512 transform (see: pbkdf2.c).
+ *
+ *  On x86-64 hosts, transforms a single block for each of
+ *  _ffx_sha512_lanes independent states, where %%h%% holds the 8 state
+ *  words and %%w%% the 16 (already unpacked) message words, each with
+ *  the lanes interleaved (i.e. h[word * _ffx_sha512_lanes + lane]). The
+ *  transform is compiled for AVX-512, AVX2 and the baseline ISA, and the
+ *  loader selects the best one for the running CPU.
+ */
+
+#if defined(__x86_64__) && defined(__GNUC__) && defined(__ELF__)
+
+typedef uint64_t LaneWord __attribute__((vector_size(8 * _ffx_sha512_lanes)));
+
+#define LANE_ROTR(x, n)   ((x >> n) | (x << (64 - n)))
+
+#define LANE_F1(x) (LANE_ROTR(x, 28) ^ LANE_ROTR(x, 34) ^ LANE_ROTR(x, 39))
+#define LANE_F2(x) (LANE_ROTR(x, 14) ^ LANE_ROTR(x, 18) ^ LANE_ROTR(x, 41))
+#define LANE_F3(x) (LANE_ROTR(x,  1) ^ LANE_ROTR(x,  8) ^ (x >> 7))
+#define LANE_F4(x) (LANE_ROTR(x, 19) ^ LANE_ROTR(x, 61) ^ (x >> 6))
+
+__attribute__((target_clones("avx512f", "avx2", "default")))
+void _ffx_hash_xformSha512Lanes(uint64_t *h, const uint64_t *w_in)
+{
+    LaneWord w[16];
+    LaneWord a, b, c, d, e, f, g, hh, k, t1, t2;
+    int j;
+
+    memcpy(w, w_in, sizeof(w));
+
+    memcpy(&a, &h[0 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&b, &h[1 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&c, &h[2 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&d, &h[3 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&e, &h[4 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&f, &h[5 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&g, &h[6 * _ffx_sha512_lanes], sizeof(LaneWord));
+    memcpy(&hh, &h[7 * _ffx_sha512_lanes], sizeof(LaneWord));
+
+    for (j = 0; j < 80; j++) {
+        if (j >= 16) {
+            w[j & 15] += LANE_F4(w[(j - 2) & 15]) + w[(j - 7) & 15]
+                         + LANE_F3(w[(j - 15) & 15]);
+        }
+
+        k = (LaneWord){ 0 } + sha512_k[j];
+
+        t1 = hh + LANE_F2(e) + (g ^ (e & (f ^ g))) + k + w[j & 15];
+        t2 = LANE_F1(a) + (b ^ ((a ^ b) & (b ^ c)));
+        hh = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+#define LANE_ADD(i, v)                                                 \
+    {                                                                  \
+        LaneWord s;                                                    \
+        memcpy(&s, &h[(i) * _ffx_sha512_lanes], sizeof(LaneWord));     \
+        s += v;                                                        \
+        memcpy(&h[(i) * _ffx_sha512_lanes], &s, sizeof(LaneWord));     \
+    }
+
+    LANE_ADD(0, a); LANE_ADD(1, b); LANE_ADD(2, c); LANE_ADD(3, d);
+    LANE_ADD(4, e); LANE_ADD(5, f); LANE_ADD(6, g); LANE_ADD(7, hh);
+
+#undef LANE_ADD
+}
+
+#endif  /* __x86_64__ */
+
 void ffx_hash_sha512(uint8_t *digest, const uint8_t *message, size_t len)
 {
     FfxSha512Context ctx;
@@ -412,34 +934,47 @@ void ffx_hash_updateSha512(FfxSha512Context *ctx, const uint8_t *message,
                    size_t len)
 {
     size_t block_nb;
-    size_t new_len, rem_len, tmp_len;
-    const uint8_t *shifted_message;
-
-    tmp_len = _ffx_sha512_block_length - ctx->len;
-    rem_len = len < tmp_len ? len : tmp_len;
+    size_t rem_len, tmp_len;
 
-    memcpy(&ctx->block[ctx->len], message, rem_len);
+    /* top up a partially filled block */
+    if (ctx->len) {
+        tmp_len = _ffx_sha512_block_length - ctx->len;
 
-    if (ctx->len + len < _ffx_sha512_block_length) {
-        ctx->len += len;
-        return;
-    }
-
-    new_len = len - rem_len;
-    block_nb = new_len / _ffx_sha512_block_length;
-
-    shifted_message = message + rem_len;
+        if (len < tmp_len) {
+            memcpy(&ctx->block[ctx->len], message, len);
+            ctx->len += len;
+            return;
+        }
 
-    sha512_transf(ctx, ctx->block, 1);
-    sha512_transf(ctx, shifted_message, block_nb);
+        memcpy(&ctx->block[ctx->len], message, tmp_len);
+        sha512_transf(ctx, ctx->block, 1);
+        ctx->tot_len += _ffx_sha512_block_length;
 
-    rem_len = new_len % _ffx_sha512_block_length;
+        message += tmp_len;
+        len -= tmp_len;
+        ctx->len = 0;
+    }
 
-    memcpy(ctx->block, &shifted_message[block_nb << 7],
-           rem_len);
+    /* full blocks are processed directly from the message */
+    block_nb = len / _ffx_sha512_block_length;
+    if (block_nb) {
+        sha512_transf(ctx, message, block_nb);
+        ctx->tot_len += block_nb << 7;
+    }
 
+    /* save leftovers */
+    rem_len = len % _ffx_sha512_block_length;
+    memcpy(ctx->block, &message[block_nb << 7], rem_len);
     ctx->len = rem_len;
-    ctx->tot_len += (block_nb + 1) << 7;
+}
+
+void ffx_hash_updateSegmentsSha512(FfxSha512Context *ctx,
+                   const FfxHashSegment *segments, size_t count)
+{
+    size_t i;
+    for (i = 0; i < count; i++) {
+        ffx_hash_updateSha512(ctx, segments[i].data, segments[i].length);
+    }
 }
 
 void ffx_hash_finalSha512(FfxSha512Context *ctx, uint8_t *digest)
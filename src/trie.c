@@ -0,0 +1,392 @@
+/**
+ *  Overview of the algorithm:
+ *
+ *  The nodes of a Merkle-Patricia Trie are:
+ *    - Leaf: [ hexPrefix(path, leaf), value ]
+ *    - Extension: [ hexPrefix(path), childRef ]
+ *    - Branch: [ childRef0, ..., childRef15, value ]
+ *
+ *  A node is referenced by its RLP-encoding if that is shorter than
+ *  32 bytes, otherwise by the RLP-encoding of its hash.
+ *
+ *  Since keys are inserted in sorted order, once the next key is known
+ *  the length it shares with the previous key determines which nodes
+ *  can no longer change, which are encoded and replaced on the stack by
+ *  their reference. The groups track which children are present at each
+ *  depth of the rightmost path, so a branch knows how many references to
+ *  pop from the stack.
+ *
+ *  For an ordered list, the keys are RLP(index) which sort as:
+ *    1, 2, ..., 127, 0, 128, 129, ...
+ *  since RLP(0) is 0x80, so the first item is held until index 128.
+ */
+
+#include <string.h>
+
+#include "firefly-trie.h"
+
+#include "firefly-hash.h"
+#include "firefly-rlp.h"
+
+
+// Each node part is either data (RLP-encoded when the node is) or a
+// node reference, which is already RLP-encoded
+typedef struct Part {
+    const uint8_t *data;
+    size_t length;
+    bool raw;
+} Part;
+
+static const uint8_t empty[1] = { 0 };
+
+static bool appendParts(FfxRlpBuilder *rlp, const Part *parts,
+  size_t count) {
+
+    ffx_rlp_appendArray(rlp, count);
+    for (int i = 0; i < count; i++) {
+        if (parts[i].raw) {
+            ffx_rlp_appendRlp(rlp, parts[i].data, parts[i].length);
+        } else {
+            ffx_rlp_appendData(rlp, parts[i].data, parts[i].length);
+        }
+    }
+
+    return (rlp->error == FfxDataErrorNone);
+}
+
+// Encodes a node directly into its reference, without buffering the
+// node; large nodes are streamed into the hash
+static FfxDataError encodeNode(FfxTrieNodeRef *ref, const Part *parts,
+  size_t count) {
+
+    size_t arrayLengths[1];
+
+    FfxRlpBuilder rlp = ffx_rlp_buildMeasure(arrayLengths, 1);
+    appendParts(&rlp, parts, count);
+    size_t length = ffx_rlp_finalize(&rlp);
+    if (rlp.error) { return rlp.error; }
+
+    if (length < 32) {
+        rlp = ffx_rlp_buildStream(ref->data, sizeof(ref->data), NULL,
+          arrayLengths, 1);
+        if (!appendParts(&rlp, parts, count)) { return rlp.error; }
+        ref->length = length;
+        return FfxDataErrorNone;
+    }
+
+    FfxKeccak256Context ctx;
+    ffx_hash_initKeccak256(&ctx);
+
+    rlp = ffx_rlp_buildStream(NULL, 0, &ctx, arrayLengths, 1);
+    if (!appendParts(&rlp, parts, count)) { return rlp.error; }
+
+    ref->data[0] = 0x80 + 32;
+    ffx_hash_finalKeccak256(&ctx, &ref->data[1]);
+    ref->length = 33;
+
+    return FfxDataErrorNone;
+}
+
+// Writes the hex-prefix encoding of %%nibbles%% to %%path%% (which
+// must be at least 1 + FFX_TRIE_MAX_KEY_NIBBLES / 2 bytes)
+static size_t getPath(uint8_t *path, const uint8_t *nibbles, size_t count,
+  bool leaf) {
+
+    uint8_t flags = (leaf ? 2: 0) | (count & 1);
+
+    size_t offset = 0;
+    if (count & 1) {
+        path[0] = (flags << 4) | nibbles[0];
+        offset = 1;
+    } else {
+        path[0] = (flags << 4);
+    }
+
+    size_t length = 1;
+    for (; offset < count; offset += 2) {
+        path[length++] = (nibbles[offset] << 4) | nibbles[offset + 1];
+    }
+
+    return length;
+}
+
+static bool push(FfxOrderedTrie *trie, const Part *parts, size_t count) {
+    if (trie->stackCount >= FFX_TRIE_MAX_STACK) {
+        trie->error = FfxDataErrorOverflow;
+        return false;
+    }
+
+    FfxTrieNodeRef ref;
+    FfxDataError error = encodeNode(&ref, parts, count);
+    if (error) {
+        trie->error = error;
+        return false;
+    }
+
+    trie->stack[trie->stackCount++] = ref;
+    return true;
+}
+
+static bool pushLeaf(FfxOrderedTrie *trie, const uint8_t *nibbles,
+  size_t count) {
+
+    uint8_t path[1 + FFX_TRIE_MAX_KEY_NIBBLES / 2];
+
+    Part parts[2] = {
+        { .data = path, .length = getPath(path, nibbles, count, true) },
+        { .data = trie->value, .length = trie->valueLength }
+    };
+
+    return push(trie, parts, 2);
+}
+
+// Replaces the top of the stack with an extension node pointing to it
+static bool pushExtension(FfxOrderedTrie *trie, const uint8_t *nibbles,
+  size_t count) {
+
+    if (trie->stackCount == 0) {
+        trie->error = FfxDataErrorBadData;
+        return false;
+    }
+
+    FfxTrieNodeRef child = trie->stack[--trie->stackCount];
+
+    uint8_t path[1 + FFX_TRIE_MAX_KEY_NIBBLES / 2];
+
+    Part parts[2] = {
+        { .data = path, .length = getPath(path, nibbles, count, false) },
+        { .data = child.data, .length = child.length, .raw = true }
+    };
+
+    return push(trie, parts, 2);
+}
+
+// Replaces the children of the group at %%depth%% on the stack with a
+// branch node pointing to them
+static bool pushBranch(FfxOrderedTrie *trie, size_t depth) {
+    uint16_t mask = trie->groups[depth];
+
+    size_t count = 0;
+    for (int i = 0; i < 16; i++) {
+        if (mask & (1 << i)) { count++; }
+    }
+
+    if (trie->stackCount < count) {
+        trie->error = FfxDataErrorBadData;
+        return false;
+    }
+
+    size_t first = trie->stackCount - count;
+
+    Part parts[17];
+    memset(parts, 0, sizeof(parts));
+
+    size_t index = first;
+    for (int i = 0; i < 16; i++) {
+        if ((mask & (1 << i)) == 0) { continue; }
+        parts[i].data = trie->stack[index].data;
+        parts[i].length = trie->stack[index].length;
+        parts[i].raw = true;
+        index++;
+    }
+
+    // The children are read from the stack while encoding, so encode
+    // before popping them
+    FfxTrieNodeRef ref;
+    FfxDataError error = encodeNode(&ref, parts, 17);
+    if (error) {
+        trie->error = error;
+        return false;
+    }
+
+    trie->stack[first] = ref;
+    trie->stackCount = first + 1;
+
+    return true;
+}
+
+// Encodes every node which will not change now that the next key is
+// known; an empty %%next%% completes the trie
+static bool update(FfxOrderedTrie *trie, const uint8_t *next,
+  size_t nextLength) {
+
+    const uint8_t *current = trie->key;
+    size_t currentLength = trie->keyLength;
+
+    bool buildExtensions = false;
+
+    while (true) {
+        bool precedingExists = (trie->groupCount > 0);
+        size_t precedingLength = precedingExists ? trie->groupCount - 1: 0;
+
+        size_t commonLength = 0;
+        while (commonLength < nextLength && commonLength < currentLength &&
+          next[commonLength] == current[commonLength]) {
+            commonLength++;
+        }
+
+        size_t depth = precedingLength;
+        if (commonLength > depth) { depth = commonLength; }
+
+        // Keys must be sorted and no key may be a prefix of another
+        if (depth >= currentLength) {
+            trie->error = FfxDataErrorBadData;
+            return false;
+        }
+
+        while (trie->groupCount <= depth) {
+            trie->groups[trie->groupCount++] = 0;
+        }
+        trie->groups[depth] |= (1 << current[depth]);
+
+        size_t offset = depth;
+        if (nextLength || precedingExists) { offset++; }
+
+        if (!buildExtensions) {
+            if (!pushLeaf(trie, &current[offset], currentLength - offset)) {
+                return false;
+            }
+        } else if (offset < currentLength) {
+            if (!pushExtension(trie, &current[offset],
+              currentLength - offset)) {
+                return false;
+            }
+        }
+
+        // The next key shares this branch, so it is not complete
+        if (precedingLength <= commonLength && nextLength) { return true; }
+
+        if (nextLength || precedingExists) {
+            if (!pushBranch(trie, depth)) { return false; }
+        }
+
+        trie->groupCount = depth;
+
+        if (precedingLength == 0) { return true; }
+
+        // Continue with the parent of the completed branch
+        currentLength = precedingLength;
+        while (trie->groupCount && trie->groups[trie->groupCount - 1] == 0) {
+            trie->groupCount--;
+        }
+
+        buildExtensions = true;
+    }
+}
+
+// Populates %%nibbles%% with the RLP-encoded %%index%%
+static size_t getKey(uint8_t *nibbles, size_t index) {
+    uint8_t key[5];
+    size_t length = 0;
+
+    if (index == 0) {
+        key[length++] = 0x80;
+    } else if (index <= 127) {
+        key[length++] = index;
+    } else {
+        size_t byteCount = 1;
+        while (byteCount < 4 && (index >> (8 * byteCount))) { byteCount++; }
+
+        key[length++] = 0x80 + byteCount;
+        for (int i = byteCount - 1; i >= 0; i--) {
+            key[length++] = index >> (8 * i);
+        }
+    }
+
+    for (int i = 0; i < length; i++) {
+        nibbles[2 * i] = key[i] >> 4;
+        nibbles[2 * i + 1] = key[i] & 0x0f;
+    }
+
+    return 2 * length;
+}
+
+static bool insert(FfxOrderedTrie *trie, size_t index, const uint8_t *value,
+  size_t length) {
+
+    uint8_t key[FFX_TRIE_MAX_KEY_NIBBLES];
+    size_t keyLength = getKey(key, index);
+
+    if (trie->keyLength && !update(trie, key, keyLength)) { return false; }
+
+    memcpy(trie->key, key, keyLength);
+    trie->keyLength = keyLength;
+
+    // Empty items are valid values, but must not be NULL to encode
+    trie->value = value ? value: empty;
+    trie->valueLength = length;
+
+    return true;
+}
+
+void ffx_trie_init(FfxOrderedTrie *trie) {
+    memset(trie, 0, sizeof(FfxOrderedTrie));
+}
+
+bool ffx_trie_append(FfxOrderedTrie *trie, const uint8_t *item,
+  size_t length) {
+
+    if (trie->error) { return false; }
+
+    size_t index = trie->count;
+
+    // The key is RLP(index), which must fit in FFX_TRIE_MAX_KEY_NIBBLES
+    if (index >= 0xffffffff) {
+        trie->error = FfxDataErrorOverflow;
+        return false;
+    }
+
+    trie->count++;
+
+    if (index == 0) {
+        trie->first = item;
+        trie->firstLength = length;
+        return true;
+    }
+
+    if (index == 128) {
+        if (!insert(trie, 0, trie->first, trie->firstLength)) {
+            return false;
+        }
+    }
+
+    return insert(trie, index, item, length);
+}
+
+bool ffx_trie_getRoot(FfxOrderedTrie *trie, uint8_t *rootOut) {
+    if (trie->error) { return false; }
+
+    if (trie->count > 0 && trie->count <= 128) {
+        if (!insert(trie, 0, trie->first, trie->firstLength)) {
+            return false;
+        }
+    }
+
+    if (trie->keyLength) {
+        if (!update(trie, NULL, 0)) { return false; }
+        trie->keyLength = 0;
+    }
+
+    // Empty trie; the hash of an empty Data
+    if (trie->stackCount == 0) {
+        uint8_t emptyData = 0x80;
+        ffx_hash_keccak256(rootOut, &emptyData, 1);
+        return true;
+    }
+
+    if (trie->stackCount != 1) {
+        trie->error = FfxDataErrorBadData;
+        return false;
+    }
+
+    FfxTrieNodeRef *root = &trie->stack[0];
+
+    // The root is always hashed, even if it could be inlined
+    if (root->length == 33) {
+        memcpy(rootOut, &root->data[1], 32);
+    } else {
+        ffx_hash_keccak256(rootOut, root->data, root->length);
+    }
+
+    return true;
+}
@@ -5,6 +5,7 @@
 #include "firefly-tx.h"
 
 #include "firefly-cbor.h"
+#include "firefly-hash.h"
 #include "firefly-rlp.h"
 
 // DEBUG: Move to utils
@@ -70,86 +71,142 @@ static FfxDataError append(FfxRlpBuilder *rlp, Format format, FfxCborCursor tx,
 }
 
 
-static FfxDataError appendAccessList(FfxRlpBuilder *rlp, FfxCborCursor tx) {
-    // Copy the access list (if any) to the RLP
+// Returns the declared count of the CBOR Array %%container%%, which can
+// not exceed the bytes remaining since each child occupies at least one
+static FfxSizeResult getArrayCount(FfxCborCursor container) {
+    if (!ffx_cbor_checkType(container, FfxCborTypeArray)) {
+        return (FfxSizeResult){ .error = FfxDataErrorBadData };
+    }
 
-    // If the accessList key is absent, use the default, an empty access list
-    FfxCborCursor accessList = ffx_cbor_followKey(tx, "accessList");
-    if (accessList.error == FfxDataErrorNotFound) {
-        ffx_rlp_appendArray(rlp, 0);
-        return rlp->error;
-    } else if (accessList.error) {
-        return accessList.error;
+    FfxSizeResult count = ffx_cbor_getContainerCount(container);
+    if (count.error) { return count; }
+
+    if (count.value > container.length - container.offset) {
+        return (FfxSizeResult){ .error = FfxDataErrorOverflow };
     }
 
-    if (!ffx_cbor_checkType(accessList, FfxCborTypeArray)) {
+    return count;
+}
+
+// Copies a single access list %%entry%% to the RLP; the RLP for an entry
+// contains at most two Arrays
+static FfxDataError appendAccessListEntry(FfxRlpBuilder *rlp,
+  FfxCborCursor entry) {
+
+    // Check: [ address, slots ]
+    if (!ffx_cbor_checkLength(entry, FfxCborTypeArray, 2)) {
         return FfxDataErrorBadData;
     }
 
-    size_t i = 0;
-    FfxRlpBuilderTag iTag = ffx_rlp_appendMutableArray(rlp);
+    ffx_rlp_appendArray(rlp, 2);
     if (rlp->error) { return rlp->error; }
 
-    FfxCborIterator iter = ffx_cbor_iterate(accessList);
-    while (ffx_cbor_nextChild(&iter)) {
+    // Check: X = [ data: 20 bytes ]
+    FfxCborCursor address = ffx_cbor_followIndex(entry, 0);
+    if (address.error) { return address.error; }
 
-        // Check: [ address, slots ]
-        if (!ffx_cbor_checkLength(iter.child, FfxCborTypeArray, 2)) {
-            return FfxDataErrorBadData;
-        }
+    {
+        FfxDataResult data = ffx_cbor_getData(address);
+        if (data.error) { return data.error; }
+        if (data.length != 20) { return FfxDataErrorBadData; }
 
-        ffx_rlp_appendArray(rlp, 2);
+        ffx_rlp_appendData(rlp, data.bytes, data.length);
         if (rlp->error) { return rlp->error; }
+    }
 
-        // Check: X = [ data: 20 bytes ]
-        FfxCborCursor address = ffx_cbor_followIndex(iter.child, 0);
-        if (address.error) { return address.error; }
+    // Check: Y = [ ]
+    FfxCborCursor slots = ffx_cbor_followIndex(entry, 1);
+    if (slots.error) { return slots.error; }
 
-        {
-            FfxDataResult data = ffx_cbor_getData(address);
-            if (data.error) { return data.error; }
-            if (data.length != 20) { return FfxDataErrorBadData; }
+    FfxSizeResult slotCount = getArrayCount(slots);
+    if (slotCount.error) { return slotCount.error; }
 
-            ffx_rlp_appendData(rlp, data.bytes, data.length);
-            if (rlp->error) { return rlp->error; }
-        }
+    ffx_rlp_appendArray(rlp, slotCount.value);
+    if (rlp->error) { return rlp->error; }
 
-        // Check: Y = [ ]
-        FfxCborCursor slots = ffx_cbor_followIndex(iter.child, 1);
-        if (slots.error) { return slots.error; }
-        if (!ffx_cbor_checkType(slots, FfxCborTypeArray)) {
-            return FfxDataErrorBadData;
-        }
+    size_t index = 0;
+    FfxCborIterator iterSlots = ffx_cbor_iterate(slots);
+    while (ffx_cbor_nextChild(&iterSlots)) {
+        FfxDataResult data = ffx_cbor_getData(iterSlots.child);
+        if (data.error) { return data.error; };
+        if (data.length != 32) { return FfxDataErrorBadData; }
 
-        size_t si = 0;
-        FfxRlpBuilderTag siTag = ffx_rlp_appendMutableArray(rlp);
+        ffx_rlp_appendData(rlp, data.bytes, data.length);
         if (rlp->error) { return rlp->error; }
 
-        FfxCborIterator iterSlots = ffx_cbor_iterate(slots);
-        while (ffx_cbor_nextChild(&iterSlots)) {
-            FfxDataResult data = ffx_cbor_getData(iterSlots.child);
-            if (data.error) { return data.error; };
-            if (data.length != 32) { return FfxDataErrorBadData; }
+        index++;
+    }
+    if (iterSlots.error) { return iterSlots.error; }
 
-            ffx_rlp_appendData(rlp, data.bytes, data.length);
-            if (rlp->error) { return rlp->error; }
+    // The data ended before the declared count
+    if (index != slotCount.value) { return FfxDataErrorBadData; }
 
-            si++;
-            ffx_rlp_adjustCount(rlp, siTag, si);
-        }
+    return FfxDataErrorNone;
+}
+
+// Finds the access list of %%tx%% and its entry count; if the accessList
+// key is absent, the default is used, an empty access list
+static FfxSizeResult getAccessList(FfxCborCursor tx,
+  FfxCborCursor *accessList) {
 
-        i++;
-        ffx_rlp_adjustCount(rlp, iTag, i);
+    *accessList = ffx_cbor_followKey(tx, "accessList");
+    if (accessList->error == FfxDataErrorNotFound) {
+        return (FfxSizeResult){ .value = 0 };
+    } else if (accessList->error) {
+        return (FfxSizeResult){ .error = accessList->error };
     }
 
-    if (iter.child.error) { return iter.child.error; }
+    return getArrayCount(*accessList);
+}
 
-    return rlp->error;
+// Calls %%appendEntry%% for each of the %%count%% entries of the
+// %%accessList%%, ensuring exactly %%count%% are present
+static FfxDataError forEachAccessListEntry(FfxCborCursor accessList,
+  size_t count, FfxDataError (*appendEntry)(void*, FfxCborCursor),
+  void *context) {
+
+    if (count == 0) { return FfxDataErrorNone; }
+
+    size_t index = 0;
+    FfxCborIterator iter = ffx_cbor_iterate(accessList);
+    while (ffx_cbor_nextChild(&iter)) {
+        FfxDataError error = appendEntry(context, iter.child);
+        if (error) { return error; }
+        index++;
+    }
+    if (iter.error) { return iter.error; }
+
+    // The data ended before the declared count
+    if (index != count) { return FfxDataErrorBadData; }
+
+    return FfxDataErrorNone;
 }
 
+static FfxDataError appendEntry(void *context, FfxCborCursor entry) {
+    return appendAccessListEntry(context, entry);
+}
+
+static FfxDataError appendAccessList(FfxRlpBuilder *rlp, FfxCborCursor tx) {
+    // Copy the access list (if any) to the RLP
+
+    FfxCborCursor accessList;
+    FfxSizeResult count = getAccessList(tx, &accessList);
+    if (count.error) { return count.error; }
 
+    ffx_rlp_appendArray(rlp, count.value);
+    if (rlp->error) { return rlp->error; }
 
-FfxDataError serialize1559(FfxCborCursor tx, FfxRlpBuilder *rlp) {
+    FfxDataError error = forEachAccessListEntry(accessList, count.value,
+      appendEntry, rlp);
+    if (error) { return error; }
+
+    return rlp->error;
+}
+
+
+// Appends the unsigned EIP-1559 Tx Array header and each field up to,
+// but not including, the access list
+static FfxDataError appendFields1559(FfxCborCursor tx, FfxRlpBuilder *rlp) {
 
     // The Unsigned EIP-1559 Tx has 9 fields
     if (!ffx_rlp_appendArray(rlp, 9)) { return rlp->error; }
@@ -181,9 +238,13 @@ FfxDataError serialize1559(FfxCborCursor tx, FfxRlpBuilder *rlp) {
     error = append(rlp, FormatData, tx, "data");
     if (error) { return error; }
 
-    //if (!ffx_rlp_appendArray(&rlp, 0)) {
-    //    return mungeDataError(rlp.error);
-    //}
+    return FfxDataErrorNone;
+}
+
+FfxDataError serialize1559(FfxCborCursor tx, FfxRlpBuilder *rlp) {
+
+    FfxDataError error = appendFields1559(tx, rlp);
+    if (error) { return error; }
 
     error = appendAccessList(rlp, tx);
     if (error) { return error; }
@@ -216,32 +277,34 @@ static FfxValueResult readNumber(FfxCborCursor tx, const char* key) {
     return (FfxValueResult){ .value = value };
 }
 
-FfxDataResult ffx_tx_serializeUnsigned(FfxCborCursor tx, uint8_t *data,
-  size_t length) {
-
-    uint8_t type = 0;
-    {
-        FfxValueResult result = readNumber(tx, "type");
-        if (result.value > 0x7f) {
-            return (FfxDataResult){ .error = FfxDataErrorUnsupportedFeature };
-        }
-        if (result.error) { return (FfxDataResult){ .error = result.error }; }
-
-        type = result.value;
+static FfxValueResult getSupportedType(FfxCborCursor tx) {
+    FfxValueResult result = readNumber(tx, "type");
+    if (result.value > 0x7f) {
+        return (FfxValueResult){ .error = FfxDataErrorUnsupportedFeature };
     }
+    if (result.error) { return result; }
 
-    switch (type) {
+    switch (result.value) {
         case 2:
             break;
         default:
-            return (FfxDataResult){ .error = FfxDataErrorUnsupportedFeature };
+            return (FfxValueResult){ .error = FfxDataErrorUnsupportedFeature };
     }
 
+    return result;
+}
+
+FfxDataResult ffx_tx_serializeUnsigned(FfxCborCursor tx, uint8_t *data,
+  size_t length) {
+
+    FfxValueResult type = getSupportedType(tx);
+    if (type.error) { return (FfxDataResult){ .error = type.error }; }
+
     // Add the EIP-2718 Envelope Type;
     if (length < 1) {
         return (FfxDataResult){ .error = FfxDataErrorBufferOverrun };
     }
-    data[0] = type;
+    data[0] = type.value;
 
     FfxDataResult result = { .bytes = data };
 
@@ -255,6 +318,109 @@ FfxDataResult ffx_tx_serializeUnsigned(FfxCborCursor tx, uint8_t *data,
     return result;
 }
 
+// Measures the RLP of a single access list %%entry%% into %%rlp%%, with
+// room in %%lengths%% for its two Arrays
+static FfxDataError measureAccessListEntry(FfxRlpBuilder *rlp,
+  size_t *lengths, FfxCborCursor entry) {
+
+    *rlp = ffx_rlp_buildMeasure(lengths, 2);
+
+    FfxDataError error = appendAccessListEntry(rlp, entry);
+    if (error) { return error; }
+
+    ffx_rlp_finalize(rlp);
+    return rlp->error;
+}
+
+// Adds the encoded length of an access list entry to the size_t context
+static FfxDataError measureEntry(void *context, FfxCborCursor entry) {
+    size_t lengths[2];
+    FfxRlpBuilder rlp;
+    FfxDataError error = measureAccessListEntry(&rlp, lengths, entry);
+    if (error) { return error; }
+
+    *(size_t*)context += rlp.offset;
+    return FfxDataErrorNone;
+}
+
+// Re-measures an access list entry and streams it to the Keccak256
+// context
+static FfxDataError streamEntry(void *context, FfxCborCursor entry) {
+    size_t lengths[2];
+    FfxRlpBuilder rlp;
+    FfxDataError error = measureAccessListEntry(&rlp, lengths, entry);
+    if (error) { return error; }
+
+    rlp = ffx_rlp_buildStream(NULL, 0, context, lengths,
+      ffx_rlp_getMeasuredArrayCount(&rlp));
+
+    error = appendAccessListEntry(&rlp, entry);
+    if (error) { return error; }
+
+    return rlp.error;
+}
+
+FfxDataError ffx_tx_getUnsignedDigest(FfxCborCursor tx, uint8_t *digestOut) {
+
+    FfxValueResult type = getSupportedType(tx);
+    if (type.error) { return type.error; }
+
+    // The access list can hold any number of entries, so each is
+    // measured (and later streamed) on its own, which keeps the Array
+    // lengths in small fixed tables
+    FfxCborCursor accessList;
+    FfxSizeResult count = getAccessList(tx, &accessList);
+    if (count.error) { return count.error; }
+
+    size_t accessListLength = 0;
+    FfxDataError error = forEachAccessListEntry(accessList, count.value,
+      measureEntry, &accessListLength);
+    if (error) { return error; }
+
+    // Measure the tx and access list Arrays; the measured count is only
+    // used to close an Array, so the access list payload is added as a
+    // single pre-measured item
+    size_t arrayLengths[2];
+    FfxRlpBuilder rlp = ffx_rlp_buildMeasure(arrayLengths, 2);
+
+    error = appendFields1559(tx, &rlp);
+    if (error) { return error; }
+
+    if (count.value) {
+        ffx_rlp_appendArray(&rlp, 1);
+        ffx_rlp_appendRlp(&rlp, NULL, accessListLength);
+    } else {
+        ffx_rlp_appendArray(&rlp, 0);
+    }
+
+    ffx_rlp_finalize(&rlp);
+    if (rlp.error) { return rlp.error; }
+
+    // Hash the EIP-2718 Envelope Type and the RLP as it is serialized
+    FfxKeccak256Context ctx;
+    ffx_hash_initKeccak256(&ctx);
+
+    uint8_t envelope = type.value;
+    ffx_hash_updateKeccak256(&ctx, &envelope, 1);
+
+    rlp = ffx_rlp_buildStream(NULL, 0, &ctx, arrayLengths,
+      ffx_rlp_getMeasuredArrayCount(&rlp));
+
+    error = appendFields1559(tx, &rlp);
+    if (error) { return error; }
+
+    ffx_rlp_appendArray(&rlp, count.value);
+    if (rlp.error) { return rlp.error; }
+
+    error = forEachAccessListEntry(accessList, count.value, streamEntry,
+      &ctx);
+    if (error) { return error; }
+
+    ffx_hash_finalKeccak256(&ctx, digestOut);
+
+    return FfxDataErrorNone;
+}
+
 static FfxRlpCursor getRlp(FfxDataResult tx) {
     if (getType(&tx) == 2) {
         if (tx.length == 0) {
@@ -0,0 +1,313 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "firefly-bloom.h"
+#include "firefly-hash.h"
+
+
+///////////////////////////////
+// Utilities
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+// Prevents the optimizer from discarding the work being benchmarked
+static volatile uint8_t sink = 0;
+
+static void report(const char *name, size_t count, size_t bytes, double dt) {
+    printf("%-32s %10.1f ns/op %10.2f MB/s\n", name, 1e9 * dt / count,
+      ((double)(count * bytes) / dt) / 1e6);
+}
+
+
+///////////////////////////////
+// Benchmark Suites
+
+static void bench_keccak256(const char *name, size_t length, size_t count) {
+    uint8_t data[length];
+    for (int i = 0; i < length; i++) { data[i] = i; }
+
+    uint8_t digest[FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i++) {
+        data[0] = digest[0];
+        ffx_hash_keccak256(digest, data, length);
+    }
+    report(name, count, length, now() - t0);
+
+    sink ^= digest[0];
+}
+
+static void bench_keccak256_64(const char *name, size_t count) {
+    uint8_t data[64];
+    for (int i = 0; i < sizeof(data); i++) { data[i] = i; }
+
+    uint8_t digest[FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i++) {
+        data[0] = digest[0];
+        ffx_hash_keccak256_64(digest, data);
+    }
+    report(name, count, sizeof(data), now() - t0);
+
+    sink ^= digest[0];
+}
+
+static void bench_keccak256Batch(const char *name, size_t length,
+  size_t count) {
+
+    #define BATCH_SIZE    (64)
+
+    uint8_t data[BATCH_SIZE][length];
+    const uint8_t *inputs[BATCH_SIZE];
+    size_t lengths[BATCH_SIZE];
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        for (int j = 0; j < length; j++) { data[i][j] = i + j; }
+        inputs[i] = data[i];
+        lengths[i] = length;
+    }
+
+    uint8_t digests[BATCH_SIZE * FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i += BATCH_SIZE) {
+        data[0][0] = digests[0];
+        ffx_hash_keccak256Batch(digests, inputs, lengths, BATCH_SIZE);
+    }
+    report(name, count, length, now() - t0);
+
+    sink ^= digests[0];
+}
+
+static void bench_sha256(const char *name, FfxHashBackend backend,
+  size_t length, size_t count) {
+
+    if (!ffx_hash_setSha256Backend(backend)) {
+        printf("%-32s (unsupported)\n", name);
+        return;
+    }
+
+    uint8_t data[length];
+    for (int i = 0; i < length; i++) { data[i] = i; }
+
+    uint8_t digest[FFX_SHA256_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i++) {
+        data[0] = digest[0];
+        ffx_hash_sha256(digest, data, length);
+    }
+    report(name, count, length, now() - t0);
+
+    ffx_hash_setSha256Backend(FfxHashBackendAuto);
+
+    sink ^= digest[0];
+}
+
+static void bench_sha256Batch(const char *name, size_t length, size_t count) {
+    ffx_hash_setSha256Backend(FfxHashBackendPortable);
+
+    uint8_t data[BATCH_SIZE][length];
+    const uint8_t *inputs[BATCH_SIZE];
+    size_t lengths[BATCH_SIZE];
+    for (int i = 0; i < BATCH_SIZE; i++) {
+        for (int j = 0; j < length; j++) { data[i][j] = i + j; }
+        inputs[i] = data[i];
+        lengths[i] = length;
+    }
+
+    uint8_t digests[BATCH_SIZE * FFX_SHA256_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i += BATCH_SIZE) {
+        data[0][0] = digests[0];
+        ffx_hash_sha256Batch(digests, inputs, lengths, BATCH_SIZE);
+    }
+    report(name, count, length, now() - t0);
+
+    ffx_hash_setSha256Backend(FfxHashBackendAuto);
+
+    sink ^= digests[0];
+}
+
+static void bench_sha512(const char *name, size_t length, size_t count) {
+    uint8_t data[length];
+    for (int i = 0; i < length; i++) { data[i] = i; }
+
+    uint8_t digest[FFX_SHA512_DIGEST_LENGTH] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i++) {
+        data[0] = digest[0];
+        ffx_hash_sha512(digest, data, length);
+    }
+    report(name, count, length, now() - t0);
+
+    sink ^= digest[0];
+}
+
+// A BIP-39 seed; PBKDF2-HMAC-SHA512 with 2048 iterations
+static void bench_pbkdf2Sha512(const char *name, size_t count) {
+    const char *password = "abandon abandon abandon abandon abandon "
+      "abandon abandon abandon abandon abandon abandon about";
+    const char *salt = "mnemonic";
+
+    uint8_t seed[64] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i++) {
+        ffx_pbkdf2_sha512(seed, sizeof(seed), 2048,
+          (const uint8_t*)password, strlen(password),
+          (const uint8_t*)salt, strlen(salt));
+    }
+    report(name, count, sizeof(seed), now() - t0);
+
+    sink ^= seed[0];
+}
+
+static void bench_pbkdf2Sha512Batch(const char *name, size_t count) {
+    #define PBKDF2_BATCH_SIZE     (4)
+
+    const char *password = "abandon abandon abandon abandon abandon "
+      "abandon abandon abandon abandon abandon abandon about";
+    const char *salt = "mnemonic";
+
+    const uint8_t *passwds[PBKDF2_BATCH_SIZE];
+    size_t passwdLengths[PBKDF2_BATCH_SIZE];
+    const uint8_t *salts[PBKDF2_BATCH_SIZE];
+    size_t saltLengths[PBKDF2_BATCH_SIZE];
+    for (int i = 0; i < PBKDF2_BATCH_SIZE; i++) {
+        passwds[i] = (const uint8_t*)password;
+        passwdLengths[i] = strlen(password);
+        salts[i] = (const uint8_t*)salt;
+        saltLengths[i] = strlen(salt);
+    }
+
+    uint8_t seeds[PBKDF2_BATCH_SIZE * 64] = { 0 };
+
+    double t0 = now();
+    for (int i = 0; i < count; i += PBKDF2_BATCH_SIZE) {
+        ffx_pbkdf2_sha512Batch(seeds, 64, 2048, passwds, passwdLengths,
+          salts, saltLengths, PBKDF2_BATCH_SIZE);
+    }
+    report(name, count, 64, now() - t0);
+
+    sink ^= seeds[0];
+}
+
+static void bench_bloomTestBatch(const char *name, size_t count) {
+
+    #define BLOOM_COUNT    (256)
+    #define QUERY_COUNT    (64)
+
+    static FfxBloom blooms[BLOOM_COUNT];
+    FfxBloomQuery queries[QUERY_COUNT];
+    static uint8_t matches[BLOOM_COUNT * QUERY_COUNT];
+
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        uint8_t item[20] = { i };
+        ffx_bloom_initQuery(&queries[i], item, sizeof(item));
+    }
+
+    for (int i = 0; i < BLOOM_COUNT; i++) {
+        ffx_bloom_init(&blooms[i]);
+        for (int j = 0; j < 16; j++) {
+            uint8_t item[20] = { i, j };
+            ffx_bloom_add(&blooms[i], item, sizeof(item));
+        }
+    }
+
+    size_t found = 0;
+
+    double t0 = now();
+    for (int i = 0; i < count; i += BLOOM_COUNT * QUERY_COUNT) {
+        found += ffx_bloom_testBatch(blooms, BLOOM_COUNT, queries,
+          QUERY_COUNT, matches);
+    }
+    report(name, count, FFX_BLOOM_LENGTH, now() - t0);
+
+    sink ^= found;
+}
+
+static void bench_bloomIncludesBatch(const char *name, size_t count) {
+    static FfxBloom blooms[BLOOM_COUNT];
+    static uint8_t matches[BLOOM_COUNT];
+
+    FfxBloom filter;
+    ffx_bloom_init(&filter);
+    for (int i = 0; i < 2; i++) {
+        uint8_t item[20] = { i };
+        ffx_bloom_add(&filter, item, sizeof(item));
+    }
+
+    for (int i = 0; i < BLOOM_COUNT; i++) {
+        ffx_bloom_init(&blooms[i]);
+        for (int j = 0; j < 16; j++) {
+            uint8_t item[20] = { i, j };
+            ffx_bloom_add(&blooms[i], item, sizeof(item));
+        }
+    }
+
+    size_t found = 0;
+
+    double t0 = now();
+    for (int i = 0; i < count; i += BLOOM_COUNT) {
+        found += ffx_bloom_includesBatch(blooms, BLOOM_COUNT, &filter,
+          matches);
+    }
+    report(name, count, FFX_BLOOM_LENGTH, now() - t0);
+
+    sink ^= found;
+}
+
+
+///////////////////////////////
+// Benchmark Bootstrap
+
+int main() {
+#ifdef FFX_KECCAK_UNROLLED
+    printf("keccak256: unrolled\n");
+#else
+    printf("keccak256: compact\n");
+#endif
+
+#ifdef FFX_SHA512_UNROLLED
+    printf("sha512: unrolled\n");
+#else
+    printf("sha512: compact\n");
+#endif
+
+    bench_keccak256("keccak256 (32 bytes)", 32, 1000000);
+    bench_keccak256("keccak256 (64 bytes)", 64, 1000000);
+    bench_keccak256("keccak256 (1024 bytes)", 1024, 100000);
+    bench_keccak256_64("keccak256_64", 1000000);
+
+    bench_keccak256Batch("keccak256Batch (32 bytes)", 32, 1000000);
+    bench_keccak256Batch("keccak256Batch (64 bytes)", 64, 1000000);
+
+    bench_sha256("sha256 portable (32 bytes)", FfxHashBackendPortable,
+      32, 1000000);
+    bench_sha256("sha256 portable (1024 bytes)", FfxHashBackendPortable,
+      1024, 100000);
+    bench_sha256("sha256 sha-ni (32 bytes)", FfxHashBackendShaNi,
+      32, 1000000);
+    bench_sha256("sha256 sha-ni (1024 bytes)", FfxHashBackendShaNi,
+      1024, 100000);
+    bench_sha256Batch("sha256Batch portable (32 bytes)", 32, 1000000);
+
+    bench_sha512("sha512 (64 bytes)", 64, 1000000);
+    bench_sha512("sha512 (1024 bytes)", 1024, 100000);
+    bench_pbkdf2Sha512("pbkdf2-sha512 (2048 rounds)", 200);
+    bench_pbkdf2Sha512Batch("pbkdf2-sha512Batch (2048 rounds)", 200);
+
+    bench_bloomTestBatch("bloom testBatch", 100000000);
+    bench_bloomIncludesBatch("bloom includesBatch", 10000000);
+
+    return 0;
+}
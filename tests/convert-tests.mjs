@@ -142,11 +142,18 @@ function BS(sig) {
 
     const output = [ ];
     for (const { name, locale, phrase, password, entropy, seed, nodes } of tests) {
-        if (locale !== "en") { continue; }
+        // The seed is computed over the NFKD normalized phrase and
+        // password, which the C library expects the caller to provide
+        const nfkd = (data) => toUtf8String(B(data)).normalize("NFKD");
+
         output.push({
-            name, password: B(password), entropy: B(entropy), seed: B(seed),
-            phrase: toUtf8String(B(phrase)),
-            nodes: nodes.map((n) => {
+            name, locale, entropy: B(entropy), seed: B(seed),
+            password: new Uint8Array(Buffer.from(nfkd(password))),
+            phrase: nfkd(phrase),
+
+            // The nodes only depend on the seed, so are only included
+            // once (for English) to keep the testcases small
+            nodes: ((locale !== "en") ? [ ]: nodes).map((n) => {
                 return {
                     chaincode: B(n.chainCode),
                     depth: n.depth,
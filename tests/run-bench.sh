@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Any arguments are passed to the compiler, which can be used to select
+# build-time variants. For example:
+#
+#   ./run-bench.sh -DFFX_KECCAK_UNROLLED -DFFX_SHA512_UNROLLED
+
+gcc \
+  -O2 -I../include \
+  "$@" \
+  bench.c \
+  ../src/bloom.c ../src/keccak.c ../src/sha2.c ../src/hmac.c ../src/pbkdf2.c \
+  -o bench.out \
+  && ./bench.out
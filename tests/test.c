@@ -3,9 +3,11 @@
 
 #include "firefly-address.h"
 #include "firefly-bip32.h"
+#include "firefly-bloom.h"
 #include "firefly-cbor.h"
 #include "firefly-ecc.h"
 #include "firefly-hash.h"
+#include "firefly-trie.h"
 #include "firefly-tx.h"
 
 #include "testcases-h/accounts.h"
@@ -13,7 +15,12 @@
 #include "testcases-h/hmac.h"
 #include "testcases-h/mnemonics.h"
 #include "testcases-h/pbkdf.h"
+
+// The transaction testcases are generated separately and may be absent
+#if __has_include("testcases-h/transactions.h")
 #include "testcases-h/transactions.h"
+#define HAS_TESTS_TRANSACTIONS
+#endif
 
 
 ///////////////////////////////
@@ -43,6 +50,12 @@ static int cmpbuf(const uint8_t *a, const uint8_t *b, size_t length) {
     return 0;
 }
 
+static void readHex(uint8_t *output, const char *hex, size_t length) {
+    for (int i = 0; i < length; i++) {
+        sscanf(&hex[2 * i], "%2hhx", &output[i]);
+    }
+}
+
 
 ///////////////////////////////
 // Testcase Check Functions
@@ -77,12 +90,110 @@ int runTestHashes(const char* name, const uint8_t *data, size_t dataLength,
     ffx_hash_sha256(digest, data, dataLength);
     if (cmpbuf(digest, sha256, 32)) { return 1; }
 
+    // The portable SHA-256 must agree with any hardware backend
+    if (ffx_hash_getSha256Backend() != FfxHashBackendPortable) {
+        ffx_hash_setSha256Backend(FfxHashBackendPortable);
+        ffx_hash_sha256(digest, data, dataLength);
+        ffx_hash_setSha256Backend(FfxHashBackendAuto);
+        if (cmpbuf(digest, sha256, 32)) { return 1; }
+    }
+
     ffx_hash_sha512(digest, data, dataLength);
     if (cmpbuf(digest, sha512, 64)) { return 1; }
 
     ffx_hash_keccak256(digest, data, dataLength);
     if (cmpbuf(digest, keccak256, 32)) { return 1; }
 
+    // Fixed-length fast paths
+    if (dataLength == 32 || dataLength == 40 || dataLength == 64) {
+        memset(digest, 0, sizeof(digest));
+        if (dataLength == 32) { ffx_hash_keccak256_32(digest, data); }
+        if (dataLength == 40) { ffx_hash_keccak256_40(digest, data); }
+        if (dataLength == 64) { ffx_hash_keccak256_64(digest, data); }
+        if (cmpbuf(digest, keccak256, 32)) { return 1; }
+    }
+
+    // Hash the data split into (uneven) segments
+    {
+        size_t a = dataLength / 3, b = dataLength / 2;
+        FfxHashSegment segments[3] = {
+            { .data = data, .length = a },
+            { .data = &data[a], .length = b - a },
+            { .data = &data[b], .length = dataLength - b }
+        };
+
+        FfxSha256Context sha256Ctx;
+        ffx_hash_initSha256(&sha256Ctx);
+        ffx_hash_updateSegmentsSha256(&sha256Ctx, segments, 3);
+        ffx_hash_finalSha256(&sha256Ctx, digest);
+        if (cmpbuf(digest, sha256, 32)) { return 1; }
+
+        FfxSha512Context sha512Ctx;
+        ffx_hash_initSha512(&sha512Ctx);
+        ffx_hash_updateSegmentsSha512(&sha512Ctx, segments, 3);
+        ffx_hash_finalSha512(&sha512Ctx, digest);
+        if (cmpbuf(digest, sha512, 64)) { return 1; }
+
+        FfxKeccak256Context keccakCtx;
+        ffx_hash_initKeccak256(&keccakCtx);
+        ffx_hash_updateSegmentsKeccak256(&keccakCtx, segments, 3);
+        ffx_hash_finalKeccak256(&keccakCtx, digest);
+        if (cmpbuf(digest, keccak256, 32)) { return 1; }
+    }
+
+    // Hash in a batch, alongside messages of other lengths
+    {
+        const uint8_t *inputs[3] = { data, data, data };
+        size_t lengths[3] = { dataLength / 2, dataLength, dataLength };
+        uint8_t digests[3 * 32];
+
+        ffx_hash_sha256Batch(digests, inputs, lengths, 3);
+        ffx_hash_sha256(digest, data, dataLength / 2);
+        if (cmpbuf(digests, digest, 32)) { return 1; }
+        if (cmpbuf(&digests[32], sha256, 32)) { return 1; }
+        if (cmpbuf(&digests[64], sha256, 32)) { return 1; }
+
+        ffx_hash_keccak256Batch(digests, inputs, lengths, 3);
+        ffx_hash_keccak256(digest, data, dataLength / 2);
+        if (cmpbuf(digests, digest, 32)) { return 1; }
+        if (cmpbuf(&digests[32], keccak256, 32)) { return 1; }
+        if (cmpbuf(&digests[64], keccak256, 32)) { return 1; }
+    }
+
+    // Hash with the first half of the data as a prepared prefix
+    FfxKeccak256Prefix prefix;
+    ffx_hash_initKeccak256Prefix(&prefix, data, dataLength / 2);
+    ffx_hash_keccak256WithPrefix(digest, &prefix, &data[dataLength / 2],
+      dataLength - dataLength / 2);
+    if (cmpbuf(digest, keccak256, 32)) { return 1; }
+
+    return 0;
+}
+
+// Checks the RIPEMD-160 of %%message%% repeated %%repeat%% times against
+// the hex %%expDigest%%
+int runTestRipemd160(const char *message, size_t repeat,
+  const char *expDigest) {
+
+    static uint8_t data[1000000];
+
+    size_t length = strlen(message);
+    if (length * repeat > sizeof(data)) { return 1; }
+    for (size_t i = 0; i < repeat; i++) {
+        memcpy(&data[i * length], message, length);
+    }
+
+    uint8_t expected[FFX_RIPEMD160_DIGEST_LENGTH];
+    readHex(expected, expDigest, FFX_RIPEMD160_DIGEST_LENGTH);
+
+    uint8_t digest[FFX_RIPEMD160_DIGEST_LENGTH];
+    ffx_hash_ripemd160(digest, data, length * repeat);
+    if (cmpbuf(digest, expected, FFX_RIPEMD160_DIGEST_LENGTH)) {
+        dumpBuffer("Actual:   ", digest, FFX_RIPEMD160_DIGEST_LENGTH);
+        dumpBuffer("Expected: ", expected, FFX_RIPEMD160_DIGEST_LENGTH);
+        return 1;
+    }
+
     return 0;
 }
 
@@ -127,28 +238,152 @@ int runTestMnemonicsNode(FfxHDNode *node, const uint8_t *chaincode,
         return 1;
     }
 
+    // Round-trip the extended key, of the node and of the neutered node
+    for (int neuter = 0; neuter < 2; neuter++) {
+        FfxHDNode source = *node;
+        if (neuter) { ffx_hdnode_neuter(&source); }
+
+        char extkey[FFX_HDNODE_EXTENDED_KEY_MAX_LENGTH];
+        if (!ffx_hdnode_getExtendedKey(&source, extkey) ||
+          strncmp(extkey, neuter ? "xpub": "xprv", 4)) {
+            printf("getExtendedKey failed\n");
+            return 1;
+        }
+
+        FfxHDNode imported;
+        if (!ffx_hdnode_initExtkey(&imported, extkey)) {
+            printf("initExtkey failed: %s\n", extkey);
+            return 1;
+        }
+
+        uint8_t actual[33];
+        ffx_hdnode_getPubkey(&imported, true, actual);
+
+        if (imported.neutered != neuter || imported.depth != depth ||
+          imported.index != index ||
+          imported.parentFingerprint != node->parentFingerprint ||
+          cmpbuf(imported.chaincode, chaincode, 32) ||
+          cmpbuf(actual, pubkey, 33)) {
+            printf("initExtkey does not match node: %s\n", extkey);
+            return 1;
+        }
+    }
+
+    // Derive children in a batch, of the node and of the neutered node
+    for (int neuter = 0; neuter < 2; neuter++) {
+        FfxHDNode parent = *node;
+        if (neuter) { ffx_hdnode_neuter(&parent); }
+
+        uint32_t fingerprint = 0;
+        if (!ffx_hdnode_getFingerprint(&parent, &fingerprint)) {
+            printf("getFingerprint failed\n");
+            return 1;
+        }
+
+        FfxHDNode children[3];
+        if (!ffx_hdnode_deriveChildren(&parent, 7, 3, children)) {
+            printf("deriveChildren failed\n");
+            return 1;
+        }
+
+        FfxAddress addresses[3];
+        FfxChecksumAddress checksums[3];
+        if (!ffx_hdnode_getAddresses(&parent, 7, 3, addresses, checksums)) {
+            printf("getAddresses failed\n");
+            return 1;
+        }
+
+        for (int i = 0; i < 3; i++) {
+            FfxHDNode child = parent;
+            ffx_hdnode_deriveChild(&child, 7 + i);
+
+            uint8_t actual[33], expected[33];
+            ffx_hdnode_getPubkey(&children[i], true, actual);
+            ffx_hdnode_getPubkey(&child, true, expected);
+
+            if (children[i].index != child.index ||
+              children[i].parentFingerprint != fingerprint ||
+              child.parentFingerprint != fingerprint ||
+              cmpbuf(children[i].chaincode, child.chaincode, 32) ||
+              cmpbuf(actual, expected, 33)) {
+                printf("deriveChildren does not match child\n");
+                return 1;
+            }
+
+            FfxEcPubkey childPubkey;
+            ffx_hdnode_getPubkey(&child, false, childPubkey.data);
+            FfxAddress address = ffx_eth_getAddress(&childPubkey);
+            FfxChecksumAddress checksum = ffx_eth_checksumAddress(&address);
+
+            if (cmpbuf(addresses[i].data, address.data, 20) ||
+              strcmp(checksums[i].text, checksum.text)) {
+                printf("getAddresses does not match child\n");
+                return 1;
+            }
+        }
+    }
+
     return 0;
 }
 
-int runTestMnemonics(const char* name, const char* phrase,
-  const char *password, size_t passwordLength,
+// Returns the language for an Ethers locale, or -1 if unknown
+static int getLanguage(const char *locale) {
+    const char* const locales[] = {
+        "en", "es", "fr", "it", "cz", "pt", "ja", "ko", "zh_cn", "zh_tw"
+    };
+
+    for (int i = 0; i < sizeof(locales) / sizeof(locales[0]); i++) {
+        if (!strcmp(locale, locales[i])) { return i; }
+    }
+
+    return -1;
+}
+
+// Japanese phrases are displayed with an ideographic space (U+3000),
+// which NFKD normalizes to a space, as used for the seed
+static void getDisplayPhrase(FfxBip39Language language, const char *phrase,
+  char *phraseOut) {
+
+    size_t offset = 0;
+    for (size_t i = 0; phrase[i]; i++) {
+        if (phrase[i] == ' ' && language == FfxBip39LanguageJapanese) {
+            memcpy(&phraseOut[offset], "\xe3\x80\x80", 3);
+            offset += 3;
+        } else {
+            phraseOut[offset++] = phrase[i];
+        }
+    }
+    phraseOut[offset] = 0;
+}
+
+int runTestMnemonics(const char* name, FfxBip39Language language,
+  const char* phrase, const char *password, size_t passwordLength,
   const uint8_t *expEntropy, size_t expEntropyLength,
   const uint8_t *expSeed, size_t expSeedLength) {
 
-    // Test Mnemonic from Phrase
+    char displayPhrase[3 * strlen(phrase) + 1];
+    getDisplayPhrase(language, phrase, displayPhrase);
 
-    FfxMnemonic mnemonic = { 0 };
-    if (!ffx_mnemonic_initPhrase(&mnemonic, phrase)) {
-        printf("initPhrase failed\n");
-        return 1;
-    }
+    // Test Mnemonic from Phrase (both NFKD and as displayed)
 
-    if (mnemonic.entropyLength != expEntropyLength||
-      cmpbuf(mnemonic.entropy, expEntropy, expEntropyLength)) {
-        printf("initPhrase did not match entropy\n");
-        return 1;
+    for (int i = 0; i < 2; i++) {
+        FfxMnemonic mnemonic = { 0 };
+        if (!ffx_mnemonic_initPhraseWithLanguage(&mnemonic,
+          i ? displayPhrase: phrase, language)) {
+            printf("initPhrase failed\n");
+            return 1;
+        }
+
+        if (mnemonic.entropyLength != expEntropyLength||
+          cmpbuf(mnemonic.entropy, expEntropy, expEntropyLength) ||
+          mnemonic.language != language) {
+            printf("initPhrase did not match entropy\n");
+            return 1;
+        }
     }
 
+    FfxMnemonic mnemonic = { 0 };
+
     // Test Mnemonic from Entropy
 
     if (!ffx_mnemonic_initEntropy(&mnemonic, expEntropy, expEntropyLength)) {
@@ -162,6 +397,122 @@ int runTestMnemonics(const char* name, const char* phrase,
         return 1;
     }
 
+    if (!ffx_mnemonic_setLanguage(&mnemonic, language)) {
+        printf("setLanguage failed\n");
+        return 1;
+    }
+
+    // Test Phrase
+
+    size_t phraseLength = ffx_mnemonic_getPhraseLength(&mnemonic);
+    char actPhrase[phraseLength];
+    if (phraseLength != strlen(displayPhrase) + 1 ||
+      !ffx_mnemonic_getPhrase(&mnemonic, actPhrase, phraseLength) ||
+      strcmp(actPhrase, displayPhrase)) {
+        printf("getPhrase did not match phrase\n");
+        return 1;
+    }
+
+    // Test Prefixes (every English word is unique within 4 letters)
+
+    for (int i = 0; i < mnemonic.wordCount; i++) {
+        char word[FFX_BIP39_MAX_WORD_LENGTH];
+        size_t wordLength = ffx_mnemonic_getWord(&mnemonic, i, word);
+        int index = ffx_bip39_getIndex(language, word, wordLength);
+
+        size_t length = ffx_bip39_getUniquePrefixLength(language, index);
+
+        int start;
+        size_t count = ffx_bip39_getPrefixRange(language, word, length,
+          &start);
+
+        if ((language == FfxBip39LanguageEnglish && length > 4) ||
+          count == 0 || (length < wordLength && count != 1) ||
+          ffx_bip39_getSortedIndex(language, start) != index) {
+            printf("getPrefixRange did not match word: %s\n", word);
+            return 1;
+        }
+    }
+
+    // Test the deprecated (English only) wordlist API
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    if (language == FfxBip39LanguageEnglish) {
+        for (int i = 0; i < mnemonic.wordCount; i++) {
+            char word[FFX_BIP39_MAX_WORD_LENGTH];
+            ffx_mnemonic_getWord(&mnemonic, i, word);
+
+            const char *oldWord = ffx_bip39_word(ffx_bip39_index(word));
+            if (oldWord == NULL || strcmp(oldWord, word)) {
+                printf("bip39_word did not match word: %s\n", word);
+                return 1;
+            }
+        }
+
+        FfxWordlistCursor cursor = { 0 };
+        int count = 0, index;
+        const char *oldWord;
+        while ((oldWord = ffx_bipd39_nextWord(&cursor, &index))) {
+            char word[FFX_BIP39_MAX_WORD_LENGTH];
+            ffx_bip39_getWord(FfxBip39LanguageEnglish, count, word);
+            if (index != count++ || strcmp(oldWord, word)) { break; }
+        }
+
+        if (count != 2048 || index != -1 || ffx_bip39_word(2048)) {
+            printf("bip39_nextWord did not match words\n");
+            return 1;
+        }
+    }
+#pragma GCC diagnostic pop
+
+    // Test Recovery (with the second word unknown and the first
+    // abbreviated, split across 2 workers)
+
+    char recoveryPhrase[strlen(phrase) + 1];
+    size_t recoveryLength = 0;
+    for (int i = 0; i < mnemonic.wordCount; i++) {
+        char word[FFX_BIP39_MAX_WORD_LENGTH];
+        size_t wordLength = ffx_mnemonic_getWord(&mnemonic, i, word);
+
+        if (i == 0) {
+            wordLength = ffx_bip39_getUniquePrefixLength(language,
+              ffx_bip39_getIndex(language, word, wordLength));
+        } else if (i == 1) {
+            strcpy(word, "?");
+            wordLength = 1;
+        }
+
+        if (i) { recoveryPhrase[recoveryLength++] = ' '; }
+        memcpy(&recoveryPhrase[recoveryLength], word, wordLength);
+        recoveryLength += wordLength;
+    }
+    recoveryPhrase[recoveryLength] = 0;
+
+    int found = 0;
+    for (int worker = 0; worker < 2; worker++) {
+        FfxMnemonicRecovery recovery;
+        if (!ffx_recovery_init(&recovery, recoveryPhrase, language,
+          worker, 2)) {
+            printf("recovery init failed: %s\n", recoveryPhrase);
+            return 1;
+        }
+
+        while (!ffx_recovery_isDone(&recovery)) {
+            if (!ffx_recovery_step(&recovery, 256)) { continue; }
+            if (recovery.mnemonic.entropyLength == expEntropyLength &&
+              !cmpbuf(recovery.mnemonic.entropy, expEntropy,
+              expEntropyLength)) {
+                found++;
+            }
+        }
+    }
+
+    if (found != 1) {
+        printf("recovery did not find mnemonic: found=%d\n", found);
+        return 1;
+    }
+
     // Test Seed
 
     uint8_t actSeed[FFX_BIP39_SEED_LENGTH] = { 0 };
@@ -178,6 +529,122 @@ int runTestMnemonics(const char* name, const char* phrase,
         return 1;
     }
 
+    // Test Seed in a batch (filling every lane)
+
+    FfxMnemonic mnemonics[5] = { mnemonic, mnemonic, mnemonic, mnemonic,
+      mnemonic };
+    uint8_t actSeeds[5 * FFX_BIP39_SEED_LENGTH] = { 0 };
+
+    if (!ffx_mnemonic_getSeedBatch(mnemonics, 5, password, actSeeds)) {
+        printf("getSeedBatch failed\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        if (cmpbuf(&actSeeds[i * FFX_BIP39_SEED_LENGTH], expSeed,
+          FFX_BIP39_SEED_LENGTH)) {
+            printf("getSeedBatch did not match seed\n");
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+// Round-trips every word of the %%language%% wordlist
+int runTestWordlist(FfxBip39Language language) {
+    char last[FFX_BIP39_MAX_WORD_LENGTH] = { 0 };
+
+    for (int position = 0; position < 2048; position++) {
+        int index = ffx_bip39_getSortedIndex(language, position);
+
+        char word[FFX_BIP39_MAX_WORD_LENGTH];
+        size_t length = ffx_bip39_getWord(language, index, word);
+        if (length == 0 || length != strlen(word) ||
+          ffx_bip39_getIndex(language, word, length) != index) {
+            printf("getIndex did not match word: %d\n", index);
+            return 1;
+        }
+
+        // The sorted positions must be in byte order
+        if (position && strcmp(last, word) >= 0) {
+            printf("getSortedIndex not in byte order: %s\n", word);
+            return 1;
+        }
+        strcpy(last, word);
+
+        // The unique prefix must not split a UTF-8 character
+        size_t prefixLength = ffx_bip39_getUniquePrefixLength(language,
+          index);
+        if (prefixLength == 0 || prefixLength > length ||
+          (word[prefixLength] & 0xc0) == 0x80) {
+            printf("getUniquePrefixLength split word: %s\n", word);
+            return 1;
+        }
+
+        int start;
+        size_t count = ffx_bip39_getPrefixRange(language, word,
+          prefixLength, &start);
+        if (start != position ||
+          (prefixLength < length && count != 1)) {
+            printf("getPrefixRange did not match word: %s\n", word);
+            return 1;
+        }
+    }
+
+    char word[FFX_BIP39_MAX_WORD_LENGTH];
+    if (ffx_bip39_getWord(language, 2048, word) ||
+      ffx_bip39_getIndex(language, "", 0) != -1) {
+        printf("getWord did not fail out of range\n");
+        return 1;
+    }
+
+    return 0;
+}
+
+// Derives the %%account%% from %%seed%% (with deriveIndexedAccount if
+// %%indexed%%, otherwise deriveAccount) without a cache, with an empty
+// %%cache%% and again with the now populated %%cache%%, checking each
+// against the hex %%expPrivkey%%
+int runTestHDAccount(const uint8_t *seed, bool indexed, uint32_t account,
+  const char *expPrivkey, FfxHDNodeCache *cache) {
+
+    uint8_t expected[32];
+    readHex(expected, expPrivkey, 32);
+
+    ffx_hdnode_clearCache(cache);
+
+    const char *names[] = { "no cache", "cache miss", "cache hit" };
+    for (int i = 0; i < 3; i++) {
+        FfxHDNodeCache *_cache = i ? cache: NULL;
+
+        FfxHDNode node;
+        if (!ffx_hdnode_initSeed(&node, seed)) {
+            printf("bad seed\n");
+            return 1;
+        }
+
+        bool success = indexed ?
+          ffx_hdnode_deriveIndexedAccountWithCache(&node, account, _cache):
+          ffx_hdnode_deriveAccountWithCache(&node, account, _cache);
+
+        uint8_t actual[32];
+        ffx_hdnode_getPrivkey(&node, actual);
+
+        if (!success || cmpbuf(actual, expected, 32)) {
+            printf("account did not match (%s)\n", names[i]);
+            dumpBuffer("Actual:   ", actual, 32);
+            dumpBuffer("Expected: ", expected, 32);
+            return 1;
+        }
+
+        // The first derivation with the cache must populate it
+        if (i == 1 && cache->tick == 0) {
+            printf("cache was not populated\n");
+            return 1;
+        }
+    }
+
     return 0;
 }
 
@@ -208,6 +675,188 @@ int runTestTxs(const char* name, const uint8_t *privkey, FfxCborCursor tx,
         return 1;
     }
 
+    // The streamed digest must match the digest of the serialized tx
+    uint8_t expDigest[FFX_KECCAK256_DIGEST_LENGTH];
+    ffx_hash_keccak256(expDigest, rlpUnsigned, rlpUnsignedLength);
+
+    uint8_t actDigest[FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
+    FfxDataError error = ffx_tx_getUnsignedDigest(tx, actDigest);
+    if (error || cmpbuf(actDigest, expDigest, FFX_KECCAK256_DIGEST_LENGTH)) {
+        printf("Unsigned TX digest did not match: status=%d\n", error);
+        dumpBuffer("Actual:   ", actDigest, FFX_KECCAK256_DIGEST_LENGTH);
+        dumpBuffer("Expected: ", expDigest, FFX_KECCAK256_DIGEST_LENGTH);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Builds an EIP-1559 tx with an access list of %%entryCount%% entries
+// (with 0 to 2 slots each) and checks its streamed digest matches the
+// digest of its serialized form
+// Appends an EIP-1559 tx map and every field but its accessList, which
+// must be appended next
+void appendTestTxFields(FfxCborBuilder *cbor) {
+    uint8_t filler[32];
+    memset(filler, 0x42, sizeof(filler));
+
+    ffx_cbor_appendMap(cbor, 10);
+
+    const char *numbers[] = { "type", "chainId", "nonce",
+      "maxPriorityFeePerGas", "maxFeePerGas", "gasLimit", "value" };
+    for (int i = 0; i < 7; i++) {
+        uint8_t value = (i == 0) ? 2: (i + 1);
+        ffx_cbor_appendString(cbor, numbers[i]);
+        ffx_cbor_appendData(cbor, &value, 1);
+    }
+
+    ffx_cbor_appendString(cbor, "to");
+    ffx_cbor_appendData(cbor, filler, 20);
+
+    ffx_cbor_appendString(cbor, "data");
+    ffx_cbor_appendData(cbor, filler, 3);
+
+    ffx_cbor_appendString(cbor, "accessList");
+}
+
+int runTestAccessList(size_t entryCount) {
+    static uint8_t cborData[16384];
+    static uint8_t rlpData[16384];
+
+    uint8_t filler[32];
+    memset(filler, 0x42, sizeof(filler));
+
+    FfxCborBuilder cbor = ffx_cbor_build(cborData, sizeof(cborData));
+    appendTestTxFields(&cbor);
+
+    ffx_cbor_appendArray(&cbor, entryCount);
+    for (size_t i = 0; i < entryCount; i++) {
+        filler[0] = i;
+        ffx_cbor_appendArray(&cbor, 2);
+        ffx_cbor_appendData(&cbor, filler, 20);
+        ffx_cbor_appendArray(&cbor, i % 3);
+        for (size_t j = 0; j < i % 3; j++) {
+            ffx_cbor_appendData(&cbor, filler, 32);
+        }
+    }
+
+    if (cbor.error) {
+        printf("Failed to build tx: status=%d\n", cbor.error);
+        return 1;
+    }
+
+    FfxCborCursor tx = ffx_cbor_walk(cborData,
+      ffx_cbor_getBuildLength(&cbor));
+
+    FfxDataResult result = ffx_tx_serializeUnsigned(tx, rlpData,
+      sizeof(rlpData));
+    if (result.error) {
+        printf("Failed to serialize unsigned tx: status=%d\n", result.error);
+        return 1;
+    }
+
+    uint8_t expDigest[FFX_KECCAK256_DIGEST_LENGTH];
+    ffx_hash_keccak256(expDigest, result.bytes, result.length);
+
+    uint8_t actDigest[FFX_KECCAK256_DIGEST_LENGTH] = { 0 };
+    FfxDataError error = ffx_tx_getUnsignedDigest(tx, actDigest);
+    if (error || cmpbuf(actDigest, expDigest, FFX_KECCAK256_DIGEST_LENGTH)) {
+        printf("Unsigned TX digest did not match: status=%d\n", error);
+        dumpBuffer("Actual:   ", actDigest, FFX_KECCAK256_DIGEST_LENGTH);
+        dumpBuffer("Expected: ", expDigest, FFX_KECCAK256_DIGEST_LENGTH);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Builds a tx whose access list declares %%declaredCount%% entries but
+// contains %%entryCount%%, each declaring %%declaredSlots%% slots but
+// containing %%slotCount%%, and checks both serializing and digesting
+// it fail with %%expError%%
+int runTestBadAccessList(size_t declaredCount, size_t entryCount,
+  size_t declaredSlots, size_t slotCount, FfxDataError expError) {
+
+    static uint8_t cborData[1024];
+    static uint8_t rlpData[1024];
+
+    uint8_t filler[32];
+    memset(filler, 0x42, sizeof(filler));
+
+    FfxCborBuilder cbor = ffx_cbor_build(cborData, sizeof(cborData));
+    appendTestTxFields(&cbor);
+
+    ffx_cbor_appendArray(&cbor, declaredCount);
+    for (size_t i = 0; i < entryCount; i++) {
+        ffx_cbor_appendArray(&cbor, 2);
+        ffx_cbor_appendData(&cbor, filler, 20);
+        ffx_cbor_appendArray(&cbor, declaredSlots);
+        for (size_t j = 0; j < slotCount; j++) {
+            ffx_cbor_appendData(&cbor, filler, 32);
+        }
+    }
+
+    if (cbor.error) {
+        printf("Failed to build tx: status=%d\n", cbor.error);
+        return 1;
+    }
+
+    FfxCborCursor tx = ffx_cbor_walk(cborData,
+      ffx_cbor_getBuildLength(&cbor));
+
+    FfxDataResult result = ffx_tx_serializeUnsigned(tx, rlpData,
+      sizeof(rlpData));
+    if (result.error != expError) {
+        printf("Unexpected serialize status: status=%d expected=%d\n",
+          result.error, expError);
+        return 1;
+    }
+
+    uint8_t digest[FFX_KECCAK256_DIGEST_LENGTH];
+    FfxDataError error = ffx_tx_getUnsignedDigest(tx, digest);
+    if (error != expError) {
+        printf("Unexpected digest status: status=%d expected=%d\n",
+          error, expError);
+        return 1;
+    }
+
+    return 0;
+}
+
+// Computes the ordered trie root of the first %%count%% of %%items%%
+// (each %%itemLength%% bytes apart, with %%lengths%%) and checks it
+// against the hex %%expRoot%%
+int runTestTrie(const uint8_t *items, size_t itemLength,
+  const size_t *lengths, size_t count, const char *expRoot) {
+
+    FfxOrderedTrie trie;
+    ffx_trie_init(&trie);
+
+    for (size_t i = 0; i < count; i++) {
+        if (!ffx_trie_append(&trie, &items[i * itemLength], lengths[i])) {
+            printf("trie append failed: index=%zu\n", i);
+            return 1;
+        }
+    }
+
+    uint8_t root[FFX_TRIE_ROOT_LENGTH];
+    if (!ffx_trie_getRoot(&trie, root)) {
+        printf("trie getRoot failed\n");
+        return 1;
+    }
+
+    char actRoot[2 * FFX_TRIE_ROOT_LENGTH + 1];
+    for (int i = 0; i < FFX_TRIE_ROOT_LENGTH; i++) {
+        sprintf(&actRoot[2 * i], "%02x", root[i]);
+    }
+
+    if (strcmp(actRoot, expRoot)) {
+        printf("trie root did not match\n");
+        printf("Actual:   0x%s\n", actRoot);
+        printf("Expected: 0x%s\n", expRoot);
+        return 1;
+    }
+
     return 0;
 }
 
@@ -337,6 +986,33 @@ int test_hashes() {
         }
     CLOSE_ARRAY()
 
+    // The RIPEMD-160 test vectors from its authors
+    const struct { const char *message; size_t repeat; const char *digest; }
+      ripemd160[] = {
+        { "", 1, "9c1185a5c5e9fc54612808977ee8f548b2258d31" },
+        { "a", 1, "0bdc9d2d256b3ee9daae347be6f4dc835a467ffe" },
+        { "abc", 1, "8eb208f7e05d987a9b044a8e98c6b087f15a0bfc" },
+        { "message digest", 1, "5d0689ef49d2fae572b881b123a85ffa21595f36" },
+        { "abcdefghijklmnopqrstuvwxyz", 1, "f71c27109c692c1b56bbdceb5b9d2865b3708dbc" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+          1, "12a053384a9c0c88e405a06c27dcf49ada62eb2b" },
+        { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+          1, "b0e20b6e3116640286ed3a87a5713079b21f5189" },
+        { "1234567890", 8, "9b752e45573d4b39f4dbd3323cab82bf63326bfb" },
+        { "a", 1000000, "52783243c1697bdbe16d37f97f68f08325dc1528" },
+    };
+
+    for (int i = 0; i < sizeof(ripemd160) / sizeof(ripemd160[0]); i++) {
+        if (runTestRipemd160(ripemd160[i].message, ripemd160[i].repeat,
+          ripemd160[i].digest)) {
+            printf("FAIL: ripemd160 (%s x %zu)\n", ripemd160[i].message,
+              ripemd160[i].repeat);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
     END_TESTS(hashes)
 }
 
@@ -367,6 +1043,27 @@ int test_hmac() {
 
         int result = cmpbuf(digest, hmac.bytes, length);
 
+        // Prepared key; used twice to check it is not consumed
+        FfxHmacSha256Key key256;
+        FfxHmacSha512Key key512;
+        if (algorithm == 256) {
+            ffx_hmac_initSha256Key(&key256, key.bytes, key.length);
+        } else {
+            ffx_hmac_initSha512Key(&key512, key.bytes, key.length);
+        }
+
+        for (int i = 0; i < 2; i++) {
+            memset(digest, 0, length);
+            if (algorithm == 256) {
+                ffx_hmac_sha256WithKey(digest, &key256, data.bytes,
+                  data.length);
+            } else {
+                ffx_hmac_sha512WithKey(digest, &key512, data.bytes,
+                  data.length);
+            }
+            result |= cmpbuf(digest, hmac.bytes, length);
+        }
+
         if (result) {
             printf("FAIL: %s\n", name);
             countFail++;
@@ -383,16 +1080,21 @@ int test_mnemonics() {
 
     OPEN_ARRAY()
         READ_STRING(name, 128)
-        READ_STRING(phrase, 512)
+        READ_STRING(locale, 16)
+        READ_STRING(phrase, 1024)
         READ_STRING(password, 256)
         READ_DATA(entropy)
         READ_DATA(seed)
 
-        if (!onlyAscii(phrase) || !onlyAscii(password)) {
+        // Only the languages with a generated wordlist are included, and
+        // passwords must be ASCII (see ffx_mnemonic_getSeed)
+        int language = getLanguage(locale);
+        if (language == -1 || !ffx_bip39_hasLanguage(language) ||
+          !onlyAscii(password)) {
             countSkip++;
 
         } else {
-            int result = runTestMnemonics(name, phrase, password,
+            int result = runTestMnemonics(name, language, phrase, password,
               strlen(password), entropy.bytes, entropy.length,
               seed.bytes, seed.length);
 
@@ -403,6 +1105,11 @@ int test_mnemonics() {
             } else {
                 countPass++;
 
+                // Shared by the nodes, which share parents
+                FfxHDNodeCacheEntry entries[4];
+                FfxHDNodeCache cache;
+                ffx_hdnode_initCache(&cache, entries, 4);
+
                 OPEN_AND_READ_ARRAY(nodes)
                     READ_DATA(chaincode)
                     READ_DATA(pubkey)
@@ -439,6 +1146,101 @@ int test_mnemonics() {
                         }
                     }
 
+                    // Derive child by path with a cache
+                    {
+                        FfxHDNode node = { 0 };
+
+                        if (!ffx_hdnode_initSeed(&node, seed.bytes)) {
+                            printf("bad seed\n");
+                            break;
+                        }
+
+                        if (!ffx_hdnode_derivePathWithCache(&node, _path,
+                          &cache)) {
+                            printf("bad path\n");
+                            break;
+                        }
+
+                        int result = runTestMnemonicsNode(&node,
+                          chaincode.bytes, privkey.bytes, pubkey.bytes,
+                          depth, index);
+
+                        if (result) {
+                            printf("FAIL: %s (%s; cached)\n", name, _path);
+                            countFail++;
+
+                        } else {
+                            countPass++;
+                        }
+                    }
+
+                    // Derive child by path with a cache, from a node with
+                    // the same chaincode but another key (which must not
+                    // share the cached nodes)
+                    {
+                        FfxHDNode node = { 0 };
+
+                        if (!ffx_hdnode_initSeed(&node, seed.bytes)) {
+                            printf("bad seed\n");
+                            break;
+                        }
+
+                        node.key.privkey.data[31] ^= 0x01;
+                        node.hasPubkey = false;
+
+                        FfxHDNode expected = node;
+
+                        if (!ffx_hdnode_derivePath(&expected, _path) ||
+                          !ffx_hdnode_derivePathWithCache(&node, _path,
+                          &cache)) {
+                            printf("bad path\n");
+                            break;
+                        }
+
+                        uint8_t actKey[32], expKey[32];
+                        ffx_hdnode_getPrivkey(&node, actKey);
+                        ffx_hdnode_getPrivkey(&expected, expKey);
+
+                        if (cmpbuf(actKey, expKey, 32) ||
+                          cmpbuf(node.chaincode, expected.chaincode, 32)) {
+                            printf("FAIL: %s (%s; cached other key)\n", name,
+                              _path);
+                            countFail++;
+
+                        } else {
+                            countPass++;
+                        }
+                    }
+
+                    // Derive child by parsed path
+                    {
+                        FfxHDNode node = { 0 };
+
+                        if (!ffx_hdnode_initSeed(&node, seed.bytes)) {
+                            printf("bad seed\n");
+                            break;
+                        }
+
+                        FfxHDPath path;
+                        if (!ffx_hdnode_parsePath(&path, _path) ||
+                          !ffx_hdnode_deriveIndices(&node, &path)) {
+                            printf("bad path\n");
+                            break;
+                        }
+
+                        int result = runTestMnemonicsNode(&node,
+                          chaincode.bytes, privkey.bytes, pubkey.bytes,
+                          depth, index);
+
+                        if (result) {
+                            printf("FAIL: %s (%s; parsed)\n", name, _path);
+                            countFail++;
+
+                        } else {
+                            countPass++;
+                        }
+                    }
+
                     // Derive child incrementally by components
                     {
                         FfxHDNode node = { 0 };
@@ -474,6 +1276,104 @@ int test_mnemonics() {
     END_TESTS(mnemonics)
 }
 
+// Records the progress reported by a PBKDF2 computation, cancelling it
+// after %%cancelAfter%% calls (if non-zero)
+typedef struct ProgressState {
+    uint32_t calls;
+    uint32_t completed;
+    uint32_t total;
+    bool monotonic;
+    uint32_t cancelAfter;
+} ProgressState;
+
+static bool onProgress(uint32_t completed, uint32_t total, void *arg) {
+    ProgressState *state = arg;
+
+    if (completed <= state->completed && state->calls) {
+        state->monotonic = false;
+    }
+    if (state->calls && total != state->total) { state->monotonic = false; }
+
+    state->calls++;
+    state->completed = completed;
+    state->total = total;
+
+    return (state->cancelAfter == 0 || state->calls < state->cancelAfter);
+}
+
+int test_wordlists() {
+    size_t countPass = 0, countFail = 0, countSkip = 0;
+
+    for (int language = 0; language <= FfxBip39LanguageChineseTraditional;
+      language++) {
+
+        if (!ffx_bip39_hasLanguage(language)) {
+            countSkip++;
+            continue;
+        }
+
+        if (runTestWordlist(language)) {
+            printf("FAIL: wordlist (language %d)\n", language);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
+    printf("wordlists: pass=%zu fail=%zu skip=%zu\n", countPass, countFail,
+      countSkip);
+    return countFail;
+}
+
+int test_hdAccounts() {
+    size_t countPass = 0, countFail = 0;
+
+    // The well-known development mnemonic; the indexed accounts are its
+    // published default keys and the others were computed with an
+    // independent BIP-32 implementation
+    FfxMnemonic mnemonic;
+    uint8_t seed[FFX_BIP39_SEED_LENGTH];
+    if (!ffx_mnemonic_initPhrase(&mnemonic, "test test test test test test "
+      "test test test test test junk") ||
+      !ffx_mnemonic_getSeed(&mnemonic, "", seed)) {
+        printf("FAIL: hdAccounts mnemonic\n");
+        return 1;
+    }
+
+    FfxHDNodeCacheEntry entries[4];
+    FfxHDNodeCache cache;
+    ffx_hdnode_initCache(&cache, entries, 4);
+
+    const struct { bool indexed; uint32_t account; const char *privkey; }
+      tests[] = {
+        // m/44'/60'/0'/0/${ account }
+        { true, 0, "ac0974bec39a17e36ba4a6b4d238ff944bacb478cbed5efcae784d7bf4f2ff80" },
+        { true, 1, "59c6995e998f97a5a0044966f0945389dc9e86dae88c7a8412f4603b6b78690d" },
+        { true, 2, "5de4111afa1a4b94908f83103eb1f1706367c2e68ca870fc3fb9a804cdab365a" },
+        { true, 19, "df57089febbacf7ba0bc227dafbffa9fc08a93fdc68e1e42411a14efcf23656e" },
+
+        // m/44'/60'/${ account }'/0/0'
+        { false, 0, "01b889f4861fc37595505809fc07b28f85bf8e8b6673aa39fc10d71a3e1f5e9a" },
+        { false, 1, "711263fefcee7b846fcd59cc9676977887bb28777bfa220a71ddb28b158ec88f" },
+        { false, 2, "9325301601d97a42b93b31897503c7dae1c7d4d98305e40d1bf444e100c3303d" },
+        { false, 19, "dc21c668e0075d7f061da1bd8e3558328d8d850b7488d42438c0d0aaf6d549ba" },
+    };
+
+    for (int i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        if (runTestHDAccount(seed, tests[i].indexed, tests[i].account,
+          tests[i].privkey, &cache)) {
+            printf("FAIL: %s account %d\n",
+              tests[i].indexed ? "indexed": "hardened", tests[i].account);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
+    printf("hdAccounts: pass=%zu fail=%zu skip=0\n", countPass, countFail);
+    return countFail;
+}
+
 int test_pbkdf() {
     START_TESTS(pbkdf)
 
@@ -499,6 +1399,74 @@ int test_pbkdf() {
 
         int result = cmpbuf(actKey, key.bytes, dkLength);
 
+        // Incrementally, in uneven steps which span blocks
+        memset(actKey, 0, dkLength);
+        if (algorithm == 256) {
+            FfxPbkdf2Sha256Context ctx;
+            ffx_pbkdf2_initSha256(&ctx, actKey, dkLength, iterations,
+              password.bytes, password.length, salt.bytes, salt.length);
+            while (!ffx_pbkdf2_stepSha256(&ctx, 7)) { }
+            ffx_pbkdf2_finalSha256(&ctx);
+        } else {
+            FfxPbkdf2Sha512Context ctx;
+            ffx_pbkdf2_initSha512(&ctx, actKey, dkLength, iterations,
+              password.bytes, password.length, salt.bytes, salt.length);
+            while (!ffx_pbkdf2_stepSha512(&ctx, 7)) { }
+            ffx_pbkdf2_finalSha512(&ctx);
+        }
+
+        result |= cmpbuf(actKey, key.bytes, dkLength);
+
+        // With progress, which must increase to the total (an iteration
+        // per block of the derived key)
+        size_t blockLength = (algorithm == 256) ? 32: 64;
+        uint32_t expTotal = iterations *
+          ((dkLength + blockLength - 1) / blockLength);
+
+        memset(actKey, 0, dkLength);
+        ProgressState state = { 0 };
+        state.monotonic = true;
+
+        bool complete;
+        if (algorithm == 256) {
+            complete = ffx_pbkdf2_sha256WithProgress(actKey, dkLength,
+              iterations, password.bytes, password.length, salt.bytes,
+              salt.length, 5, onProgress, &state);
+        } else {
+            complete = ffx_pbkdf2_sha512WithProgress(actKey, dkLength,
+              iterations, password.bytes, password.length, salt.bytes,
+              salt.length, 5, onProgress, &state);
+        }
+
+        if (!complete || !state.monotonic || state.total != expTotal ||
+          state.completed != expTotal) {
+            printf("progress did not reach total\n");
+            result |= 1;
+        }
+
+        result |= cmpbuf(actKey, key.bytes, dkLength);
+
+        // With progress, cancelled by the first callback
+        if (expTotal > 5) {
+            ProgressState state = { 0 };
+            state.cancelAfter = 1;
+
+            if (algorithm == 256) {
+                complete = ffx_pbkdf2_sha256WithProgress(actKey, dkLength,
+                  iterations, password.bytes, password.length, salt.bytes,
+                  salt.length, 5, onProgress, &state);
+            } else {
+                complete = ffx_pbkdf2_sha512WithProgress(actKey, dkLength,
+                  iterations, password.bytes, password.length, salt.bytes,
+                  salt.length, 5, onProgress, &state);
+            }
+
+            if (complete || state.calls != 1 || state.completed != 5) {
+                printf("progress did not cancel\n");
+                result |= 1;
+            }
+        }
+
         if (result) {
             printf("FAIL: %s\n", name);
             countFail++;
@@ -511,6 +1479,10 @@ int test_pbkdf() {
 }
 
 int test_transactions() {
+#ifndef HAS_TESTS_TRANSACTIONS
+    printf("transactions: skipped (no testcases)\n");
+    return 0;
+#else
     START_TESTS(transactions)
 
     OPEN_ARRAY()
@@ -541,6 +1513,268 @@ int test_transactions() {
     CLOSE_ARRAY()
 
     END_TESTS(transactions)
+#endif
+}
+
+int test_accessLists() {
+    size_t countPass = 0, countFail = 0;
+
+    // Across the sizes which once overflowed the measured Array lengths
+    const size_t counts[] = { 0, 1, 2, 31, 32, 33, 64, 100 };
+    for (int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        if (runTestAccessList(counts[i])) {
+            printf("FAIL: access list (%zu entries)\n", counts[i]);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
+    // Declared counts which the data cannot hold must fail rather than
+    // size anything from the count
+    const struct {
+        size_t declaredCount, entryCount, declaredSlots, slotCount;
+        FfxDataError error;
+    } bad[] = {
+        { 0xffffff, 0, 0, 0, FfxDataErrorOverflow },
+        { 3, 2, 0, 0, FfxDataErrorBadData },
+        { 1, 1, 0xffffff, 0, FfxDataErrorOverflow },
+        { 1, 1, 2, 1, FfxDataErrorBufferOverrun },
+    };
+    for (int i = 0; i < sizeof(bad) / sizeof(bad[0]); i++) {
+        if (runTestBadAccessList(bad[i].declaredCount, bad[i].entryCount,
+          bad[i].declaredSlots, bad[i].slotCount, bad[i].error)) {
+            printf("FAIL: bad access list (%zu of %zu entries)\n",
+              bad[i].entryCount, bad[i].declaredCount);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
+    printf("accessLists: pass=%zu fail=%zu skip=0\n", countPass, countFail);
+    return countFail;
+}
+
+int test_trie() {
+    size_t countPass = 0, countFail = 0;
+
+    // The roots of the first count items, where item i is 1 + (7 * i % 90)
+    // bytes of ((i + j) * 13) & 0xff; covers inline and hashed nodes and
+    // keys on either side of the 0x7f / 0x80 and 1-byte / 2-byte index
+    // boundaries (computed with an independent reference trie; the empty
+    // root is that of every block without transactions)
+    const struct { size_t count; const char *root; } tests[] = {
+        { 0, "56e81f171bcc55a6ff8345e692c0f86e5b48e01b996cadc001622fb5e363b421" },
+        { 1, "7da536f7df63a0dfb481590e53be0e3063d9b798925cc3d479a3eb3155d0b394" },
+        { 2, "5f579ae661b145c55ad5bf1bb0a66a99e2e070be357ab8bcb516e7ee516c48b4" },
+        { 3, "99a76fffbc25df3faa9c227a32f8cb2abe5ca061e3a96b9745487adb585d019f" },
+        { 16, "23ca6d9e66452c19b1e3948986cfc242462f9d50be1412bf140ace661b145bbc" },
+        { 17, "7c031372711ec8e4caade9246aeceb35e1ea6891efc055121993cde1dee4c39d" },
+        { 127, "1f20de929f40b37c6428855f213791cbf579c99686e4262dc86bc7b894a53a3a" },
+        { 128, "c8e11c68eb48af0401ca780fc4ad5f734e8ab57b96fb9d8e6c436c7fabee6cdf" },
+        { 129, "2cd578302c9fdd340f6dad02ae9f8be1e2c12aa7986cbb3a80926d6768554b50" },
+        { 130, "b26d2d24fc4eeb35a50723c379104266a1fac283be222f0e37fba726620f643f" },
+        { 255, "ff6ed0f9bb2192b073e09c78dd8238d343d1b1d8e6f085c3f38ef00aa578d100" },
+        { 256, "472a4ec3a6faaa93d778b06c9c0ce2c6f09e63bc7345ba85ba6867cd6416b565" },
+        { 257, "05dbfbc62e7c95195e5cc1808ea2539a3bde0dca794e9efda08b67142040475d" },
+        { 1000, "aaf115ec9bd9e0cbfeaaed58808a77f98efa87feff2de08e4a81ee669c2927e6" },
+    };
+
+    #define TRIE_ITEMS            (1000)
+    #define TRIE_ITEM_LENGTH      (90)
+
+    static uint8_t items[TRIE_ITEMS * TRIE_ITEM_LENGTH];
+    static size_t lengths[TRIE_ITEMS];
+    for (size_t i = 0; i < TRIE_ITEMS; i++) {
+        lengths[i] = 1 + (i * 7) % TRIE_ITEM_LENGTH;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            items[i * TRIE_ITEM_LENGTH + j] = ((i + j) * 13) & 0xff;
+        }
+    }
+
+    for (int i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        if (runTestTrie(items, TRIE_ITEM_LENGTH, lengths, tests[i].count,
+          tests[i].root)) {
+            printf("FAIL: trie (%zu items)\n", tests[i].count);
+            countFail++;
+        } else {
+            countPass++;
+        }
+    }
+
+    printf("trie: pass=%zu fail=%zu skip=0\n", countPass, countFail);
+    return countFail;
+}
+
+int test_bloom() {
+    size_t countPass = 0, countFail = 0;
+
+    #define CHECK_BLOOM(NAME,COND) \
+        if (COND) { \
+            countPass++; \
+        } else { \
+            printf("FAIL: bloom %s\n", (NAME)); \
+            countFail++; \
+        }
+
+    // A WETH Deposit(address,uint256) log (to the Uniswap V2 Router)
+    FfxAddress weth;
+    readHex(weth.data, "c02aaa39b223fe8d0a0e5c4f27ead9083c756cc2", 20);
+
+    uint8_t topics[2 * 32];
+    readHex(topics, "e1fffcc4923d04b559f4d29a8bfc6cda04eb5b0d3c460751c2402c5c5cc9109c"
+      "0000000000000000000000007a250d5630b4cf539739df2c5dacb4c659f2488d", 64);
+
+    // A USDC Transfer(address,address,uint256) log, which shares no bits
+    FfxAddress usdc;
+    readHex(usdc.data, "a0b86991c6218b36c1d19d4a2e9eb0ce3606eb48", 20);
+
+    uint8_t transfer[32];
+    readHex(transfer,
+      "ddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef", 32);
+
+    // The receipt logsBloom of each
+    FfxBloom expLog, expOther;
+    readHex(expLog.data,
+      "0000000000000000000000000000000000000000000000000001000000000000"
+      "0000000000000000000000000000000002000000080000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000080000000"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000004000000000000000000001000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000002000"
+      "0000200000000000000000000000000000000000000000400000000000000000", FFX_BLOOM_LENGTH);
+    readHex(expOther.data,
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000000"
+      "0000000000000000080000080000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000001000000000"
+      "0000000000000000000000000000000000000000010000000000000000000000"
+      "0000000000002000000000000000000000000000000000000000000000000000"
+      "0000000200000000000000000000000000000000000000000000000000000000"
+      "0000000000000000000000000000000000000000000000000000000000000000", FFX_BLOOM_LENGTH);
+
+    FfxBloom empty;
+    ffx_bloom_init(&empty);
+    CHECK_BLOOM("init",
+      cmpbuf(empty.data, (uint8_t[FFX_BLOOM_LENGTH]){ 0 }, FFX_BLOOM_LENGTH) == 0);
+
+    FfxBloom blooms[3];
+    ffx_bloom_init(&blooms[0]);
+    ffx_bloom_addLog(&blooms[0], &weth, topics, 2);
+    if (cmpbuf(blooms[0].data, expLog.data, FFX_BLOOM_LENGTH)) {
+        dumpBuffer("Actual:  ", blooms[0].data, FFX_BLOOM_LENGTH);
+        dumpBuffer("Expected:", expLog.data, FFX_BLOOM_LENGTH);
+        CHECK_BLOOM("addLog", false);
+    } else {
+        CHECK_BLOOM("addLog", true);
+    }
+
+    ffx_bloom_init(&blooms[1]);
+    ffx_bloom_add(&blooms[1], usdc.data, sizeof(usdc.data));
+    ffx_bloom_add(&blooms[1], transfer, sizeof(transfer));
+    CHECK_BLOOM("add",
+      cmpbuf(blooms[1].data, expOther.data, FFX_BLOOM_LENGTH) == 0);
+
+    blooms[2] = empty;
+
+    // Queries: the WETH address, Deposit topic, USDC address and the
+    // Transfer topic
+    FfxBloomQuery queries[4];
+    ffx_bloom_initQuery(&queries[0], weth.data, sizeof(weth.data));
+    ffx_bloom_initQuery(&queries[1], topics, 32);
+    ffx_bloom_initQuery(&queries[2], usdc.data, sizeof(usdc.data));
+    ffx_bloom_initQuery(&queries[3], transfer, sizeof(transfer));
+
+    {
+        FfxBloom bloom;
+        ffx_bloom_init(&bloom);
+        ffx_bloom_addQuery(&bloom, &queries[2]);
+        ffx_bloom_addQuery(&bloom, &queries[3]);
+        CHECK_BLOOM("addQuery",
+          cmpbuf(bloom.data, expOther.data, FFX_BLOOM_LENGTH) == 0);
+    }
+
+    const uint8_t expMatches[3][4] = {
+        { 1, 1, 0, 0 },
+        { 0, 0, 1, 1 },
+        { 0, 0, 0, 0 },
+    };
+
+    for (int b = 0; b < 3; b++) {
+        for (int q = 0; q < 4; q++) {
+            CHECK_BLOOM("test",
+              ffx_bloom_test(&blooms[b], &queries[q]) == expMatches[b][q]);
+        }
+    }
+
+    {
+        uint8_t matches[3 * 4];
+        memset(matches, 0xff, sizeof(matches));
+        size_t count = ffx_bloom_testBatch(blooms, 3, queries, 4, matches);
+        CHECK_BLOOM("testBatch count", count == 4);
+        CHECK_BLOOM("testBatch matches",
+          cmpbuf(matches, &expMatches[0][0], sizeof(matches)) == 0);
+    }
+
+    // Filters: WETH Deposit logs and USDC Transfer logs
+    FfxBloom filters[2];
+    for (int f = 0; f < 2; f++) {
+        ffx_bloom_init(&filters[f]);
+        ffx_bloom_addQuery(&filters[f], &queries[2 * f]);
+        ffx_bloom_addQuery(&filters[f], &queries[2 * f + 1]);
+    }
+
+    for (int b = 0; b < 3; b++) {
+        for (int f = 0; f < 2; f++) {
+            CHECK_BLOOM("includes",
+              ffx_bloom_includes(&blooms[b], &filters[f]) == (b == f));
+        }
+        CHECK_BLOOM("includes empty", ffx_bloom_includes(&blooms[b], &empty));
+    }
+
+    // A filter only partially included (WETH address, Transfer topic)
+    {
+        FfxBloom mixed;
+        ffx_bloom_init(&mixed);
+        ffx_bloom_addQuery(&mixed, &queries[0]);
+        ffx_bloom_addQuery(&mixed, &queries[3]);
+        CHECK_BLOOM("includes partial",
+          !ffx_bloom_includes(&blooms[0], &mixed) &&
+          !ffx_bloom_includes(&blooms[1], &mixed));
+
+        // ...but a block bloom merged from both receipts includes all
+        FfxBloom block;
+        ffx_bloom_init(&block);
+        for (int b = 0; b < 3; b++) { ffx_bloom_merge(&block, &blooms[b]); }
+        int same = 1;
+        for (int i = 0; i < FFX_BLOOM_LENGTH; i++) {
+            if (block.data[i] != (expLog.data[i] | expOther.data[i])) {
+                same = 0;
+            }
+        }
+        CHECK_BLOOM("merge", same);
+        CHECK_BLOOM("includes merged",
+          ffx_bloom_includes(&block, &mixed) &&
+          ffx_bloom_includes(&block, &filters[0]) &&
+          ffx_bloom_includes(&block, &filters[1]));
+    }
+
+    for (int f = 0; f < 2; f++) {
+        uint8_t matches[3];
+        memset(matches, 0xff, sizeof(matches));
+        size_t count = ffx_bloom_includesBatch(blooms, 3, &filters[f],
+          matches);
+        CHECK_BLOOM("includesBatch count", count == 1);
+        CHECK_BLOOM("includesBatch matches",
+          matches[0] == (f == 0) && matches[1] == (f == 1) && matches[2] == 0);
+    }
+
+    #undef CHECK_BLOOM
+
+    printf("bloom: pass=%zu fail=%zu skip=0\n", countPass, countFail);
+    return countFail;
 }
 
 
@@ -554,8 +1788,13 @@ int main() {
     countFail += test_hashes();
     countFail += test_hmac();
     countFail += test_mnemonics();
+    countFail += test_wordlists();
+    countFail += test_hdAccounts();
     countFail += test_pbkdf();
     countFail += test_transactions();
+    countFail += test_accessLists();
+    countFail += test_trie();
+    countFail += test_bloom();
 
     printf("Total: %zu failed\n", countFail);
 